@@ -346,6 +346,17 @@ static int bl1_fwu_image_copy(unsigned int image_id,
 					image_id);
 			return -EPERM;
 		}
+
+		/*
+		 * Hash the image as it is copied so that authentication only
+		 * has to check the final digest. If that is not possible, the
+		 * image is hashed in full at authentication time.
+		 */
+		if (auth_mod_stream_start(image_id,
+				(void *)desc->image_info.image_base) != 0) {
+			VERBOSE("BL1-FWU: Image id %d hashed at authentication\n",
+				image_id);
+		}
 	}
 
 	/* Everything looks sane. Go ahead and copy the block of data. */
@@ -353,6 +364,12 @@ static int bl1_fwu_image_copy(unsigned int image_id,
 	(void)memcpy((void *) dest_addr, (const void *) image_src, block_size);
 	flush_dcache_range(dest_addr, block_size);
 
+	/*
+	 * Hash the secure copy, not the source, which the non-secure world can
+	 * still modify.
+	 */
+	auth_mod_stream_update(image_id, (const void *)dest_addr, block_size);
+
 	desc->copied_size += block_size;
 	desc->state = (block_size == remaining) ?
 		IMAGE_STATE_COPIED : IMAGE_STATE_COPYING;
@@ -443,6 +460,10 @@ static int bl1_fwu_image_auth(unsigned int image_id,
 	 */
 	INFO("BL1-FWU: Authenticating image_id:%d\n", image_id);
 	result = auth_mod_verify_img(image_id, (void *)base_addr, total_size);
+
+	/* The incremental hash, if any, is of no use once authenticated */
+	auth_mod_stream_abort(image_id);
+
 	if (result != 0) {
 		WARN("BL1-FWU: Authentication Failed err=%d\n", result);
 
@@ -725,6 +746,8 @@ static int bl1_fwu_image_reset(unsigned int image_id, unsigned int flags)
 					desc->copied_size);
 		}
 
+		auth_mod_stream_abort(image_id);
+
 		/* Reset status variables */
 		desc->copied_size = 0;
 		desc->image_info.image_size = 0;
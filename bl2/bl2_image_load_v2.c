@@ -5,6 +5,7 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <platform_def.h>
@@ -14,11 +15,150 @@
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <common/desc_image_load.h>
+#include <common/tbbr/tbbr_img_def.h>
 #include <drivers/auth/auth_mod.h>
+#include <drivers/io/io_driver.h>
+#include <drivers/io/io_fip.h>
+#include <drivers/io/io_storage.h>
 #include <plat/common/platform.h>
 
 #include "bl2_private.h"
 
+/*******************************************************************************
+ * Print the IO operations done since boot, to compare the cost of the image
+ * loading sequence between storage configurations.
+ ******************************************************************************/
+static void bl2_print_io_stats(void)
+{
+	const io_stats_t *stats = io_get_stats();
+	unsigned int type;
+
+	INFO("BL2: IO %u device init, %u device close, %u open\n",
+	     stats->dev_init, stats->dev_close, stats->open);
+
+	for (type = 0U; type < (unsigned int)IO_TYPE_MAX; type++) {
+		if (stats->read[type] != 0U) {
+			INFO("BL2: IO type %u: %u read, %llu bytes\n", type,
+			     stats->read[type], stats->read_bytes[type]);
+		}
+	}
+}
+
+#if TRUSTED_BOARD_BOOT && BL2_STORAGE_ORDER_LOAD
+#ifndef PLAT_BL2_CERT_BUF_SIZE
+#define PLAT_BL2_CERT_BUF_SIZE		U(0x1000)
+#endif
+
+static uint8_t bl2_cert_buf[PLAT_BL2_CERT_BUF_SIZE] __aligned(8);
+
+/* Return the offset of an image in the FIP, SIZE_MAX if it is not known */
+static size_t bl2_get_storage_offset(unsigned int image_id)
+{
+	uintptr_t dev_handle;
+	uintptr_t image_spec;
+	uintptr_t image_handle;
+	size_t offset = SIZE_MAX;
+
+	if (plat_get_image_source(image_id, &dev_handle, &image_spec) != 0) {
+		return SIZE_MAX;
+	}
+
+	if (io_open(dev_handle, image_spec, &image_handle) == 0) {
+		if (fip_file_get_offset(image_handle, &offset) != 0) {
+			offset = SIZE_MAX;
+		}
+
+		(void)io_close(image_handle);
+	}
+
+	(void)io_dev_close(dev_handle);
+
+	return offset;
+}
+
+/* Certificate chain to authenticate, with the FIP offset sorting it */
+struct bl2_cert_chain {
+	unsigned int image_id;
+	size_t offset;
+};
+
+static struct bl2_cert_chain bl2_cert_chains[MAX_NUMBER_IDS];
+
+/*
+ * Load and authenticate the certificates of all the images to load before
+ * the images themselves. A chain of trust must be authenticated from its root
+ * down, and key certificates may share the buffer of the key they extract, so
+ * the chains are processed one at a time, sorted by the FIP offset of the
+ * certificate authenticating the image itself. The certificates a chain
+ * shares with a previous one are not read again. The FIP offsets are looked
+ * up once per image. The images are then loaded in the platform order, as
+ * their load address may depend on the post-load handling of the previous
+ * ones.
+ *
+ * Images skipped at this point are not covered, e.g. the OP-TEE pager and
+ * pageable parts that BL32 post-load handling may enable. With the TBBR chain
+ * of trust, they share the content certificate of BL32, authenticated here.
+ * Otherwise their certificates are authenticated as they are loaded.
+ *
+ * On error, the regular image loading reports it or tries another boot
+ * source.
+ */
+static void bl2_load_certs_in_storage_order(const bl_load_info_t *load_info)
+{
+	image_info_t cert_info = { 0 };
+	const bl_load_info_node_t *node;
+	unsigned int nb_chains = 0U;
+	unsigned int i, j;
+
+	SET_PARAM_HEAD(&cert_info, PARAM_IMAGE_BINARY, VERSION_2, 0U);
+	cert_info.image_base = (uintptr_t)bl2_cert_buf;
+	cert_info.image_max_size = sizeof(bl2_cert_buf);
+
+	for (node = load_info->head; node != NULL;
+	     node = node->next_load_info) {
+		struct bl2_cert_chain chain;
+		unsigned int cert_id;
+
+		if (((node->image_info->h.attr &
+		      IMAGE_ATTRIB_SKIP_LOADING) != 0U) ||
+		    (auth_mod_get_parent_id(node->image_id, &cert_id) != 0)) {
+			continue;
+		}
+
+		assert(nb_chains < ARRAY_SIZE(bl2_cert_chains));
+
+		chain.image_id = node->image_id;
+		chain.offset = bl2_get_storage_offset(cert_id);
+
+		/* Insertion sort, stable for equal or unknown offsets */
+		for (i = nb_chains;
+		     (i > 0U) && (bl2_cert_chains[i - 1U].offset > chain.offset);
+		     i--) {
+			bl2_cert_chains[i] = bl2_cert_chains[i - 1U];
+		}
+
+		bl2_cert_chains[i] = chain;
+		nb_chains++;
+	}
+
+	for (j = 0U; j < nb_chains; j++) {
+		int err;
+
+		VERBOSE("BL2: Certificates of image id %d at offset 0x%lx\n",
+			bl2_cert_chains[j].image_id,
+			(unsigned long)bl2_cert_chains[j].offset);
+
+		err = load_auth_image_parents(bl2_cert_chains[j].image_id,
+					      &cert_info);
+		if (err != 0) {
+			VERBOSE("BL2: Certificates of image id %d failed (%i)\n",
+				bl2_cert_chains[j].image_id, err);
+			break;
+		}
+	}
+}
+#endif /* TRUSTED_BOARD_BOOT && BL2_STORAGE_ORDER_LOAD */
+
 /*******************************************************************************
  * This function loads SCP_BL2/BL3x images and returns the ep_info for
  * the next executable image.
@@ -29,6 +169,9 @@ struct entry_point_info *bl2_load_images(void)
 	bl_load_info_t *bl2_load_info;
 	const bl_load_info_node_t *bl2_node_info;
 	int plat_setup_done = 0;
+#if TRUSTED_BOARD_BOOT && BL2_STORAGE_ORDER_LOAD
+	bool certs_loaded = false;
+#endif
 	int err;
 
 	/*
@@ -41,6 +184,9 @@ struct entry_point_info *bl2_load_images(void)
 	assert(bl2_load_info->h.version >= VERSION_2);
 	bl2_node_info = bl2_load_info->head;
 
+	/* Keep the storage devices open until all images are loaded */
+	io_session_begin();
+
 	while (bl2_node_info != NULL) {
 		/*
 		 * Perform platform setup before loading the image,
@@ -66,6 +212,17 @@ struct entry_point_info *bl2_load_images(void)
 
 		if ((bl2_node_info->image_info->h.attr &
 		    IMAGE_ATTRIB_SKIP_LOADING) == 0U) {
+#if TRUSTED_BOARD_BOOT && BL2_STORAGE_ORDER_LOAD
+			/*
+			 * Done once platform setup and pre-image load handling
+			 * of the first image allow storage accesses.
+			 */
+			if (!certs_loaded) {
+				bl2_load_certs_in_storage_order(bl2_load_info);
+				certs_loaded = true;
+			}
+#endif
+
 			INFO("BL2: Loading image id %d\n", bl2_node_info->image_id);
 			err = load_auth_image(bl2_node_info->image_id,
 				bl2_node_info->image_info);
@@ -89,6 +246,10 @@ struct entry_point_info *bl2_load_images(void)
 		bl2_node_info = bl2_node_info->next_load_info;
 	}
 
+	io_session_end();
+
+	bl2_print_io_stats();
+
 	/*
 	 * Get information to pass to the next image.
 	 */
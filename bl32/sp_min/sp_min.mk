@@ -28,6 +28,14 @@ BL32_SOURCES		+=	lib/extensions/amu/aarch32/amu.c\
 				lib/extensions/amu/aarch32/amu_helpers.S
 endif
 
+# Flag to accumulate PMU counters per SMC function ID handled by SP_MIN. The
+# results are read through a platform service. It is default disabled.
+SP_MIN_PMU_STATS	?= 0
+
+ifeq (${SP_MIN_PMU_STATS},1)
+BL32_SOURCES		+=	bl32/sp_min/sp_min_pmu.c
+endif
+
 ifeq (${WORKAROUND_CVE_2017_5715},1)
 BL32_SOURCES		+=	bl32/sp_min/wa_cve_2017_5715_bpiall.S	\
 				bl32/sp_min/wa_cve_2017_5715_icache_inv.S
@@ -54,3 +62,6 @@ $(eval $(call assert_boolean,RESET_TO_SP_MIN))
 SP_MIN_WITH_SECURE_FIQ 	?= 0
 $(eval $(call add_define,SP_MIN_WITH_SECURE_FIQ))
 $(eval $(call assert_boolean,SP_MIN_WITH_SECURE_FIQ))
+
+$(eval $(call add_define,SP_MIN_PMU_STATS))
+$(eval $(call assert_boolean,SP_MIN_PMU_STATS))
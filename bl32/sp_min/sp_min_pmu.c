@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <platform_def.h>
+
+#include <arch.h>
+#include <arch_helpers.h>
+#include <common/runtime_svc.h>
+#include <lib/spinlock.h>
+#include <lib/utils.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+#include <sp_min_pmu.h>
+
+/* Architectural common events counted on the event counters */
+#define PMU_EVT_L1D_CACHE_REFILL	0x03U
+#define PMU_EVT_L1D_TLB_REFILL		0x05U
+#define PMU_EVT_INST_RETIRED		0x08U
+#define PMU_EVT_L2D_CACHE_REFILL	0x17U
+
+#define PMU_NB_EVENTS			(SP_MIN_PMU_NB_COUNTERS - 1U)
+
+static const uint32_t pmu_event[PMU_NB_EVENTS] = {
+	PMU_EVT_INST_RETIRED,
+	PMU_EVT_L1D_CACHE_REFILL,
+	PMU_EVT_L2D_CACHE_REFILL,
+	PMU_EVT_L1D_TLB_REFILL,
+};
+
+/* Non-secure PMU state saved across the SMC handling */
+struct pmu_regs {
+	uint32_t pmcr;
+	uint32_t cnten;
+	uint32_t ovs;
+	uint32_t selr;
+	uint32_t ccfiltr;
+	uint32_t ccntr;
+	uint32_t evtyper[PMU_NB_EVENTS];
+	uint32_t evcntr[PMU_NB_EVENTS];
+};
+
+struct pmu_fid_stats {
+	uint32_t calls;
+	uint64_t counter[SP_MIN_PMU_NB_COUNTERS];
+};
+
+/*
+ * Function IDs are only appended, under the lock, so that a core finds its
+ * slot without taking it. Each core accumulates in its own counters.
+ *
+ * Starting the statistics bumps pmu_generation instead of clearing the
+ * counters of the other cores, which may be accounting an SMC. A core
+ * clears its own counters once it sees the new generation, and the counters
+ * of a core still on a previous generation are not read.
+ */
+static uint32_t pmu_fid[SP_MIN_PMU_MAX_FIDS];
+static unsigned int pmu_fid_count;
+static struct pmu_fid_stats pmu_stats[PLATFORM_CORE_COUNT][SP_MIN_PMU_MAX_FIDS];
+static unsigned int pmu_generation;
+static unsigned int pmu_core_generation[PLATFORM_CORE_COUNT];
+static bool pmu_enabled;
+static spinlock_t pmu_lock;
+
+static unsigned int pmu_nb_events(void)
+{
+	unsigned int n = (read_pmcr() & PMCR_N_BITS) >> PMCR_N_SHIFT;
+
+	return MIN(n, PMU_NB_EVENTS);
+}
+
+static uint32_t pmu_counters_mask(unsigned int nb_events)
+{
+	return PMCNTEN_C_BIT | (BIT_32(nb_events) - 1U);
+}
+
+/* Stop the non-secure counters and save them */
+static void pmu_save(struct pmu_regs *regs, unsigned int nb_events)
+{
+	unsigned int i;
+
+	regs->pmcr = read_pmcr();
+	regs->cnten = read_pmcntenset();
+	write_pmcntenclr(pmu_counters_mask(nb_events));
+	isb();
+
+	regs->ovs = read_pmovsr();
+	regs->selr = read_pmselr();
+	regs->ccntr = read_pmccntr();
+
+	for (i = 0U; i < nb_events; i++) {
+		write_pmselr(i);
+		isb();
+		regs->evtyper[i] = read_pmxevtyper();
+		regs->evcntr[i] = read_pmxevcntr();
+	}
+
+	write_pmselr(PMSELR_CCFILTR);
+	isb();
+	regs->ccfiltr = read_pmxevtyper();
+}
+
+static void pmu_restore(const struct pmu_regs *regs, unsigned int nb_events)
+{
+	uint32_t mask = pmu_counters_mask(nb_events);
+	unsigned int i;
+
+	for (i = 0U; i < nb_events; i++) {
+		write_pmselr(i);
+		isb();
+		write_pmxevtyper(regs->evtyper[i]);
+		write_pmxevcntr(regs->evcntr[i]);
+	}
+
+	write_pmselr(PMSELR_CCFILTR);
+	isb();
+	write_pmxevtyper(regs->ccfiltr);
+	write_pmselr(regs->selr);
+	write_pmccntr(regs->ccntr);
+
+	/* Drop the overflows raised while counting for the secure world */
+	write_pmovsr(mask & ~regs->ovs);
+
+	write_pmcntenset(regs->cnten & mask);
+	write_pmcr(regs->pmcr);
+	isb();
+}
+
+/* Count all modes, the counters reset, the cycle counter not divided */
+static void pmu_start(unsigned int nb_events)
+{
+	uint32_t mask = pmu_counters_mask(nb_events);
+	unsigned int i;
+
+	for (i = 0U; i < nb_events; i++) {
+		write_pmselr(i);
+		isb();
+		write_pmxevtyper(pmu_event[i]);
+	}
+
+	write_pmselr(PMSELR_CCFILTR);
+	isb();
+	write_pmxevtyper(0U);
+
+	write_pmcr(PMCR_E_BIT | PMCR_P_BIT | PMCR_C_BIT);
+	write_pmovsr(mask);
+	write_pmcntenset(mask);
+	isb();
+}
+
+static void pmu_stop(uint32_t *counter, unsigned int nb_events)
+{
+	unsigned int i;
+
+	write_pmcntenclr(pmu_counters_mask(nb_events));
+	isb();
+
+	counter[SP_MIN_PMU_CYCLES] = read_pmccntr();
+
+	for (i = 0U; i < PMU_NB_EVENTS; i++) {
+		counter[i + 1U] = 0U;
+
+		if (i < nb_events) {
+			write_pmselr(i);
+			isb();
+			counter[i + 1U] = read_pmxevcntr();
+		}
+	}
+}
+
+static int pmu_fid_slot(uint32_t smc_fid)
+{
+	unsigned int count = pmu_fid_count;
+	unsigned int i;
+
+	dmbish();
+
+	for (i = 0U; i < count; i++) {
+		if (pmu_fid[i] == smc_fid) {
+			return (int)i;
+		}
+	}
+
+	spin_lock(&pmu_lock);
+
+	for (i = 0U; i < pmu_fid_count; i++) {
+		if (pmu_fid[i] == smc_fid) {
+			break;
+		}
+	}
+
+	if (i == pmu_fid_count) {
+		if (i == SP_MIN_PMU_MAX_FIDS) {
+			spin_unlock(&pmu_lock);
+			return -ENOMEM;
+		}
+
+		pmu_fid[i] = smc_fid;
+		dmbish();
+		pmu_fid_count = i + 1U;
+	}
+
+	spin_unlock(&pmu_lock);
+
+	return (int)i;
+}
+
+/*
+ * Account the counters of an SMC entered at @generation. An SMC that spans
+ * a restart of the statistics is dropped.
+ */
+static void pmu_account(uint32_t smc_fid, const uint32_t *counter,
+			unsigned int generation)
+{
+	unsigned int core = plat_my_core_pos();
+	struct pmu_fid_stats *stats;
+	unsigned int i;
+	int slot;
+
+	if (generation != pmu_generation) {
+		return;
+	}
+
+	if (pmu_core_generation[core] != generation) {
+		zeromem(pmu_stats[core], sizeof(pmu_stats[core]));
+		dmbish();
+		pmu_core_generation[core] = generation;
+	}
+
+	slot = pmu_fid_slot(smc_fid);
+	if (slot < 0) {
+		return;
+	}
+
+	stats = &pmu_stats[core][slot];
+	stats->calls++;
+
+	for (i = 0U; i < SP_MIN_PMU_NB_COUNTERS; i++) {
+		stats->counter[i] += counter[i];
+	}
+}
+
+/*
+ * Handle an SMC with the PMU counting for the secure world when the
+ * statistics are enabled. An SMC that does not return, like a PSCI CPU_OFF,
+ * is not accounted. The secure world only counts when secure non-invasive
+ * debug is allowed.
+ */
+uintptr_t sp_min_pmu_handle_smc(uint32_t smc_fid, void *cookie, void *handle,
+				unsigned int flags)
+{
+	struct pmu_regs ns_regs;
+	uint32_t counter[SP_MIN_PMU_NB_COUNTERS];
+	unsigned int generation;
+	unsigned int nb_events;
+	uintptr_t ret;
+
+	if (!pmu_enabled) {
+		return handle_runtime_svc(smc_fid, cookie, handle, flags);
+	}
+
+	generation = pmu_generation;
+	dmbish();
+	nb_events = pmu_nb_events();
+
+	pmu_save(&ns_regs, nb_events);
+	pmu_start(nb_events);
+
+	ret = handle_runtime_svc(smc_fid, cookie, handle, flags);
+
+	pmu_stop(counter, nb_events);
+	pmu_account(smc_fid, counter, generation);
+	pmu_restore(&ns_regs, nb_events);
+
+	return ret;
+}
+
+void sp_min_pmu_stats_start(void)
+{
+	spin_lock(&pmu_lock);
+
+	pmu_enabled = false;
+	pmu_fid_count = 0U;
+	zeromem(pmu_fid, sizeof(pmu_fid));
+	dmbish();
+	pmu_generation++;
+	dmbish();
+	pmu_enabled = true;
+
+	spin_unlock(&pmu_lock);
+}
+
+void sp_min_pmu_stats_stop(void)
+{
+	pmu_enabled = false;
+}
+
+unsigned int sp_min_pmu_stats_count(void)
+{
+	return pmu_fid_count;
+}
+
+int sp_min_pmu_stats_read(unsigned int index, struct sp_min_pmu_stats *stats)
+{
+	unsigned int core;
+	unsigned int i;
+
+	assert(stats != NULL);
+
+	if (index >= pmu_fid_count) {
+		return -EINVAL;
+	}
+
+	zeromem(stats, sizeof(*stats));
+	stats->smc_fid = pmu_fid[index];
+
+	for (core = 0U; core < PLATFORM_CORE_COUNT; core++) {
+		const struct pmu_fid_stats *fid_stats = &pmu_stats[core][index];
+
+		if (pmu_core_generation[core] != pmu_generation) {
+			continue;
+		}
+
+		dmbish();
+
+		stats->calls += fid_stats->calls;
+
+		for (i = 0U; i < SP_MIN_PMU_NB_COUNTERS; i++) {
+			stats->counter[i] += fid_stats->counter[i];
+		}
+	}
+
+	return 0;
+}
@@ -8,6 +8,8 @@
 #include <errno.h>
 #include <string.h>
 
+#include <platform_def.h>
+
 #include <arch.h>
 #include <arch_features.h>
 #include <arch_helpers.h>
@@ -59,6 +61,62 @@ uintptr_t page_align(uintptr_t value, unsigned dir)
 	return value;
 }
 
+/*
+ * Read an image to its load address. When the chain of trust holds the hashes
+ * of its successive chunks, each chunk is verified as soon as it is read, so
+ * that a corrupted image is rejected without reading it to the end.
+ */
+static int load_image_read(unsigned int image_id, uintptr_t image_handle,
+			   uintptr_t image_base, size_t image_size)
+{
+	uintptr_t buf = image_base;
+	size_t len = image_size;
+	size_t bytes_read;
+	int io_result;
+#if TRUSTED_BOARD_BOOT
+	unsigned int chunk_size = 0U;
+	unsigned int idx = 0U;
+#endif
+
+#if TRUSTED_BOARD_BOOT
+	if ((dyn_is_auth_disabled() == 0) &&
+	    (auth_mod_get_chunk_size(image_id, &chunk_size) == 0)) {
+		len = chunk_size;
+	}
+#endif
+
+	while (buf < (image_base + image_size)) {
+		len = MIN(len, (size_t)(image_base + image_size - buf));
+
+		/* TODO: Consider whether to try to recover/retry a partially successful read */
+		io_result = io_read(image_handle, buf, len, &bytes_read);
+		if ((io_result != 0) || (bytes_read < len)) {
+			WARN("Failed to load image id=%u (%i)\n", image_id,
+			     io_result);
+			return io_result;
+		}
+
+#if TRUSTED_BOARD_BOOT
+		if ((chunk_size != 0U) &&
+		    (auth_mod_verify_chunk(image_id, idx, (void *)buf,
+					   (unsigned int)len) != 0)) {
+			WARN("Image id=%u chunk %u authentication failed\n",
+			     image_id, idx);
+			/* Zero memory and flush it right away */
+			zero_normalmem((void *)image_base, buf + len - image_base);
+			flush_dcache_range(image_base, buf + len - image_base);
+			return -EAUTH;
+		}
+
+		idx++;
+#endif
+
+		buf += len;
+	}
+
+	return 0;
+}
+
 /*******************************************************************************
  * Internal function to load an image at a specific address given
  * an image ID and extents of free memory.
@@ -74,7 +132,6 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 	uintptr_t image_spec;
 	uintptr_t image_base;
 	size_t image_size;
-	size_t bytes_read;
 	int io_result;
 
 	assert(image_data != NULL);
@@ -122,10 +179,9 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 	image_data->image_size = (uint32_t)image_size;
 
 	/* We have enough space so load the image now */
-	/* TODO: Consider whether to try to recover/retry a partially successful read */
-	io_result = io_read(image_handle, image_base, image_size, &bytes_read);
-	if ((io_result != 0) || (bytes_read < image_size)) {
-		WARN("Failed to load image id=%u (%i)\n", image_id, io_result);
+	io_result = load_image_read(image_id, image_handle, image_base,
+				    image_size);
+	if (io_result != 0) {
 		goto exit;
 	}
 
@@ -136,13 +192,65 @@ exit:
 	(void)io_close(image_handle);
 	/* Ignore improbable/unrecoverable error in 'close' */
 
-	/* TODO: Consider maintaining open device connection from this bootloader stage */
+	/* Deferred to the end of the IO session when one is active */
 	(void)io_dev_close(dev_handle);
 	/* Ignore improbable/unrecoverable error in 'dev_close' */
 
 	return io_result;
 }
 
+/*
+ * Above this size, a loaded image is flushed by set/way over the whole data
+ * cache rather than by address. This must only be enabled by platforms loading
+ * images while a single CPU is running.
+ */
+#ifndef PLAT_IMAGE_DCACHE_SW_THRESHOLD
+#define PLAT_IMAGE_DCACHE_SW_THRESHOLD	U(0)
+#endif
+
+#ifdef __aarch64__
+#define IMAGE_DCACHE_SW_OP		DCCISW
+#else
+#define IMAGE_DCACHE_SW_OP		DC_OP_CISW
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+static uint64_t image_flush_time_us(void)
+{
+	u_register_t freq = read_cntfrq_el0();
+
+	if (freq == 0U) {
+		return 0ULL;
+	}
+
+	return (read_cntpct_el0() * 1000000ULL) / freq;
+}
+#endif
+
+/*
+ * Flush an image out to main memory so that it can be executed later by any
+ * CPU, regardless of cache and MMU state.
+ */
+void flush_image_dcache(uintptr_t base, size_t size)
+{
+#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+	uint64_t start_us = image_flush_time_us();
+#endif
+
+	if ((PLAT_IMAGE_DCACHE_SW_THRESHOLD != 0U) &&
+	    (size > PLAT_IMAGE_DCACHE_SW_THRESHOLD)) {
+		dcsw_op_all(IMAGE_DCACHE_SW_OP);
+	} else {
+		flush_dcache_range(base, size);
+	}
+
+#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+	VERBOSE("Image 0x%lx: 0x%lx bytes flushed in %lu us\n",
+		(unsigned long)base, (unsigned long)size,
+		(unsigned long)(image_flush_time_us() - start_us));
+#endif
+}
+
 /*
  * Load an image and flush it out to main memory so that it can be executed
  * later by any CPU, regardless of cache and MMU state.
@@ -154,7 +262,7 @@ static int load_image_flush(unsigned int image_id,
 
 	rc = load_image(image_id, image_data);
 	if (rc == 0) {
-		flush_dcache_range(image_data->image_base,
+		flush_image_dcache(image_data->image_base,
 				   image_data->image_size);
 	}
 
@@ -208,12 +316,108 @@ static int load_auth_image_recursive(unsigned int image_id,
 	 * child images, not for the parents (certificates).
 	 */
 	if (is_parent_image == 0) {
-		flush_dcache_range(image_data->image_base,
+		flush_image_dcache(image_data->image_base,
 				   image_data->image_size);
 	}
 
 	return 0;
 }
+
+/*
+ * Load and authenticate, from the root of trust down, the certificates of the
+ * chain of trust of an image that are not authenticated yet. cert_data is
+ * used as load area for the certificates. The image itself is not loaded.
+ */
+int load_auth_image_parents(unsigned int image_id, image_info_t *cert_data)
+{
+	unsigned int parent_id;
+
+	if ((dyn_is_auth_disabled() != 0) ||
+	    (auth_mod_get_parent_id(image_id, &parent_id) != 0)) {
+		return 0;
+	}
+
+	return load_auth_image_recursive(parent_id, cert_data, 1);
+}
+
+/* Return the size of an image in storage */
+static int get_image_size(unsigned int image_id, size_t *image_size)
+{
+	uintptr_t dev_handle;
+	uintptr_t image_handle;
+	uintptr_t image_spec;
+	int io_result;
+
+	io_result = plat_get_image_source(image_id, &dev_handle, &image_spec);
+	if (io_result != 0) {
+		return io_result;
+	}
+
+	io_result = io_open(dev_handle, image_spec, &image_handle);
+	if (io_result == 0) {
+		io_result = io_size(image_handle, image_size);
+		(void)io_close(image_handle);
+	}
+
+	(void)io_dev_close(dev_handle);
+
+	return io_result;
+}
+
+/*
+ * Authenticate an image that is already at its load address, e.g. left there
+ * by a previous boot, as if it had just been loaded: its size is the one of
+ * the image in storage, and its chain of trust is loaded and authenticated
+ * from the root of trust down, NV counters included. The certificates are
+ * loaded in the load area of the image, after the image itself. The image is
+ * not modified, so that it can still be loaded on error.
+ */
+int auth_image_in_place(unsigned int image_id, image_info_t *image_data)
+{
+	image_info_t cert_data;
+	uintptr_t cert_base;
+	size_t image_size = 0U;
+	int rc;
+
+	assert(image_data != NULL);
+	assert(image_data->h.version >= VERSION_2);
+
+	if (dyn_is_auth_disabled() != 0) {
+		return -EAUTH;
+	}
+
+	rc = get_image_size(image_id, &image_size);
+	if ((rc != 0) || (image_size == 0U)) {
+		return (rc != 0) ? rc : -EIO;
+	}
+
+	cert_base = round_up(image_data->image_base + image_size, 8U);
+	if (cert_base >= (image_data->image_base +
+			  image_data->image_max_size)) {
+		return -ENOMEM;
+	}
+
+	cert_data = *image_data;
+	cert_data.image_base = cert_base;
+	cert_data.image_max_size = (uint32_t)(image_data->image_base +
+					      image_data->image_max_size -
+					      cert_base);
+
+	rc = load_auth_image_parents(image_id, &cert_data);
+	if (rc != 0) {
+		return rc;
+	}
+
+	rc = auth_mod_verify_img(image_id, (void *)image_data->image_base,
+				 (unsigned int)image_size);
+	if (rc != 0) {
+		return -EAUTH;
+	}
+
+	image_data->image_size = (uint32_t)image_size;
+
+	return 0;
+}
 #endif /* TRUSTED_BOARD_BOOT */
 
 static int load_auth_image_internal(unsigned int image_id,
@@ -241,7 +445,13 @@ int load_auth_image(unsigned int image_id, image_info_t *image_data)
 
 	do {
 		err = load_auth_image_internal(image_id, image_data);
-	} while ((err != 0) && (plat_try_next_boot_source(image_id) != 0));
+		if (err == 0) {
+			break;
+		}
+
+		/* Devices are re-initialised from the next boot source */
+		io_session_flush();
+	} while (plat_try_next_boot_source(image_id) != 0);
 
 	return err;
 }
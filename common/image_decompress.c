@@ -74,7 +74,7 @@ int image_decompress(struct image_info *info)
 	/* image_base is updated to the final pos when decompressor() exits. */
 	info->image_size = image_base - info->image_base;
 
-	flush_dcache_range(info->image_base, info->image_size);
+	flush_image_dcache(info->image_base, info->image_size);
 
 	return 0;
 }
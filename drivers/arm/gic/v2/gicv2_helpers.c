@@ -157,30 +157,27 @@ void gicv2_secure_spis_configure_props(uintptr_t gicd_base,
 }
 
 /*******************************************************************************
- * Helper function to configure properties of secure G0 SGIs and PPIs.
+ * Helper function to compute the register images of the secure G0 SGIs and
+ * PPIs from the interrupt properties, so that each CPU can apply them with
+ * full register writes.
  ******************************************************************************/
-void gicv2_secure_ppi_sgi_setup_props(uintptr_t gicd_base,
-		const interrupt_prop_t *interrupt_props,
-		unsigned int interrupt_props_num)
+void gicv2_secure_ppi_sgi_build_cfg(const interrupt_prop_t *interrupt_props,
+		unsigned int interrupt_props_num, gicv2_pcpu_cfg_t *cfg)
 {
-	unsigned int i;
-	uint32_t sec_ppi_sgi_mask = 0;
+	unsigned int i, shift;
+	uint32_t sec_ppi_sgi_mask = 0U;
 	const interrupt_prop_t *prop_desc;
 
 	/* Make sure there's a valid property array */
 	if (interrupt_props_num != 0U)
 		assert(interrupt_props != NULL);
 
-	/*
-	 * Disable all SGIs (imp. def.)/PPIs before configuring them. This is a
-	 * more scalable approach as it avoids clearing the enable bits in the
-	 * GICD_CTLR.
-	 */
-	gicd_write_icenabler(gicd_base, 0U, ~0U);
+	cfg->icfgr_mask = 0U;
+	cfg->icfgr = 0U;
 
-	/* Setup the default PPI/SGI priorities doing four at a time */
-	for (i = 0U; i < MIN_SPI_ID; i += 4U)
-		gicd_write_ipriorityr(gicd_base, i, GICD_IPRIORITYR_DEF_VAL);
+	/* Default PPI/SGI priorities */
+	for (i = 0U; i < ARRAY_SIZE(cfg->ipriorityr); i++)
+		cfg->ipriorityr[i] = GICD_IPRIORITYR_DEF_VAL;
 
 	for (i = 0U; i < interrupt_props_num; i++) {
 		prop_desc = &interrupt_props[i];
@@ -195,26 +192,130 @@ void gicv2_secure_ppi_sgi_setup_props(uintptr_t gicd_base,
 		 * Set interrupt configuration for PPIs. Configuration for SGIs
 		 * are ignored.
 		 */
-		if ((prop_desc->intr_num >= MIN_PPI_ID) &&
-				(prop_desc->intr_num < MIN_SPI_ID)) {
-			gicd_set_icfgr(gicd_base, prop_desc->intr_num,
-					prop_desc->intr_cfg);
+		if (prop_desc->intr_num >= MIN_PPI_ID) {
+			shift = (prop_desc->intr_num &
+				 ((1U << ICFGR_SHIFT) - 1U)) << 1;
+			cfg->icfgr_mask |= GIC_CFG_MASK << shift;
+			cfg->icfgr &= ~(GIC_CFG_MASK << shift);
+			cfg->icfgr |= (prop_desc->intr_cfg & GIC_CFG_MASK) <<
+				      shift;
 		}
 
 		/* We have an SGI or a PPI. They are Group0 at reset */
 		sec_ppi_sgi_mask |= (1u << prop_desc->intr_num);
 
 		/* Set the priority of this interrupt */
-		gicd_set_ipriorityr(gicd_base, prop_desc->intr_num,
-				prop_desc->intr_pri);
+		shift = (prop_desc->intr_num &
+			 ((1U << IPRIORITYR_SHIFT) - 1U)) << 3;
+		cfg->ipriorityr[prop_desc->intr_num >> IPRIORITYR_SHIFT] &=
+			~(GIC_PRI_MASK << shift);
+		cfg->ipriorityr[prop_desc->intr_num >> IPRIORITYR_SHIFT] |=
+			(prop_desc->intr_pri & GIC_PRI_MASK) << shift;
 	}
 
-	/*
-	 * Invert the bitmask to create a mask for non-secure PPIs and SGIs.
-	 * Program the GICD_IGROUPR0 with this bit mask.
-	 */
-	gicd_write_igroupr(gicd_base, 0, ~sec_ppi_sgi_mask);
+	cfg->igroupr = ~sec_ppi_sgi_mask;
+	cfg->isenabler = sec_ppi_sgi_mask;
+}
+
+/*******************************************************************************
+ * Helper function to program the secure G0 SGIs and PPIs of the calling CPU
+ * from register images built by gicv2_secure_ppi_sgi_build_cfg().
+ ******************************************************************************/
+void gicv2_secure_ppi_sgi_apply_cfg(uintptr_t gicd_base,
+		const gicv2_pcpu_cfg_t *cfg)
+{
+	unsigned int i;
+	uint32_t icfgr;
+
+	/* Disable all SGIs (imp. def.)/PPIs before configuring them */
+	gicd_write_icenabler(gicd_base, 0U, ~0U);
+
+	for (i = 0U; i < ARRAY_SIZE(cfg->ipriorityr); i++)
+		gicd_write_ipriorityr(gicd_base, i << IPRIORITYR_SHIFT,
+				      cfg->ipriorityr[i]);
+
+	/* Only touch the PPI configuration fields of secure interrupts */
+	if (cfg->icfgr_mask != 0U) {
+		icfgr = gicd_read_icfgr(gicd_base, MIN_PPI_ID);
+		gicd_write_icfgr(gicd_base, MIN_PPI_ID,
+				 (icfgr & ~cfg->icfgr_mask) | cfg->icfgr);
+	}
+
+	gicd_write_igroupr(gicd_base, 0U, cfg->igroupr);
 
 	/* Enable the Group 0 SGIs and PPIs */
-	gicd_write_isenabler(gicd_base, 0, sec_ppi_sgi_mask);
+	gicd_write_isenabler(gicd_base, 0U, cfg->isenabler);
+}
+
+/* Assemble a register value from 4 consecutive byte fields, lowest first */
+static uint32_t bytes_to_reg(const uint8_t *bytes)
+{
+	return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) |
+	       ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+/*******************************************************************************
+ * Helper function to program the attributes of all SPIs described by register
+ * images, one full register write at a time. SPIs beyond the images are set to
+ * their default attributes.
+ ******************************************************************************/
+void gicv2_spis_apply_cfg(uintptr_t gicd_base, const gicv2_spi_cfg_t *cfg)
+{
+	unsigned int index, num_ints, word;
+
+	/* Images must cover whole registers */
+	assert((cfg->num_spis & 31U) == 0U);
+
+	num_ints = gicd_read_typer(gicd_base);
+	num_ints &= TYPER_IT_LINES_NO_MASK;
+	num_ints = (num_ints + 1U) << 5;
+
+	/* Images start at the first SPI, whose ID is word aligned */
+	for (index = MIN_SPI_ID; index < num_ints; index += 32U) {
+		word = (index - MIN_SPI_ID) >> IGROUPR_SHIFT;
+		if (word < GICV2_SPI_CFG_WORDS(cfg->num_spis)) {
+			gicd_write_igroupr(gicd_base, index,
+					   cfg->igroupr[word]);
+		} else {
+			gicd_write_igroupr(gicd_base, index, ~0U);
+		}
+	}
+
+	for (index = MIN_SPI_ID; index < num_ints; index += 4U) {
+		if ((index - MIN_SPI_ID) < cfg->num_spis) {
+			gicd_write_ipriorityr(gicd_base, index,
+				bytes_to_reg(&cfg->ipriorityr[index -
+							      MIN_SPI_ID]));
+		} else {
+			gicd_write_ipriorityr(gicd_base, index,
+					      GICD_IPRIORITYR_DEF_VAL);
+		}
+	}
+
+	for (index = MIN_SPI_ID; index < num_ints; index += 16U) {
+		word = (index - MIN_SPI_ID) >> ICFGR_SHIFT;
+		if (word < GICV2_SPI_CFG_ICFGR_WORDS(cfg->num_spis)) {
+			gicd_write_icfgr(gicd_base, index, cfg->icfgr[word]);
+		} else {
+			gicd_write_icfgr(gicd_base, index, 0U);
+		}
+	}
+
+	for (index = MIN_SPI_ID;
+	     (index < num_ints) && ((index - MIN_SPI_ID) < cfg->num_spis);
+	     index += 4U) {
+		gicd_write_itargetsr(gicd_base, index,
+			bytes_to_reg(&cfg->itargetsr[index - MIN_SPI_ID]));
+	}
+
+	/* Enable the secure SPIs last, once they are fully configured */
+	for (index = MIN_SPI_ID;
+	     (index < num_ints) && ((index - MIN_SPI_ID) < cfg->num_spis);
+	     index += 32U) {
+		word = (index - MIN_SPI_ID) >> IGROUPR_SHIFT;
+		if (cfg->isenabler[word] != 0U) {
+			gicd_write_isenabler(gicd_base, index,
+					     cfg->isenabler[word]);
+		}
+	}
 }
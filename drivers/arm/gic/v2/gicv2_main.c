@@ -20,6 +20,9 @@
 
 static const gicv2_driver_data_t *driver_data;
 
+/* Secure SGI/PPI configuration programmed by each CPU, see gicv2_driver_init() */
+static gicv2_pcpu_cfg_t pcpu_cfg;
+
 /*
  * Spinlock to guard registers needing read-modify-write. APIs protected by this
  * spinlock are used either at boot time (when only a single CPU is active), or
@@ -80,9 +83,7 @@ void gicv2_pcpu_distif_init(void)
 	assert(driver_data != NULL);
 	assert(driver_data->gicd_base != 0U);
 
-	gicv2_secure_ppi_sgi_setup_props(driver_data->gicd_base,
-			driver_data->interrupt_props,
-			driver_data->interrupt_props_num);
+	gicv2_secure_ppi_sgi_apply_cfg(driver_data->gicd_base, &pcpu_cfg);
 
 	/* Enable G0 interrupts if not already */
 	ctlr = gicd_read_ctlr(driver_data->gicd_base);
@@ -121,6 +122,143 @@ void gicv2_distif_init(void)
 	gicd_write_ctlr(driver_data->gicd_base, ctlr | CTLR_ENABLE_G0_BIT);
 }
 
+/*******************************************************************************
+ * Same as gicv2_distif_init(), except that the SPIs are programmed from the
+ * register images in 'spi_cfg' with full register writes. The images are
+ * expected to have been set up by gicv2_spi_cfg_init().
+ ******************************************************************************/
+void gicv2_distif_init_spi_cfg(const gicv2_spi_cfg_t *spi_cfg)
+{
+	unsigned int ctlr;
+
+	assert(driver_data != NULL);
+	assert(driver_data->gicd_base != 0U);
+	assert(spi_cfg != NULL);
+
+	/* Disable the distributor before going further */
+	ctlr = gicd_read_ctlr(driver_data->gicd_base);
+	gicd_write_ctlr(driver_data->gicd_base,
+			ctlr & ~(CTLR_ENABLE_G0_BIT | CTLR_ENABLE_G1_BIT));
+
+	gicv2_spis_apply_cfg(driver_data->gicd_base, spi_cfg);
+
+	/* Re-enable the secure SPIs now that they have been configured */
+	gicd_write_ctlr(driver_data->gicd_base, ctlr | CTLR_ENABLE_G0_BIT);
+}
+
+/*******************************************************************************
+ * Set SPI register images to the default attributes of SPIs, then record the
+ * secure SPIs from the platform interrupt properties. Those target the calling
+ * CPU, as in gicv2_distif_init().
+ ******************************************************************************/
+void gicv2_spi_cfg_init(gicv2_spi_cfg_t *spi_cfg)
+{
+	unsigned int i;
+	const interrupt_prop_t *prop_desc;
+	int rc __unused;
+
+	assert(driver_data != NULL);
+	assert(driver_data->gicd_base != 0U);
+	assert(spi_cfg != NULL);
+
+	for (i = 0U; i < GICV2_SPI_CFG_WORDS(spi_cfg->num_spis); i++) {
+		spi_cfg->igroupr[i] = ~0U;
+		spi_cfg->isenabler[i] = 0U;
+	}
+
+	for (i = 0U; i < GICV2_SPI_CFG_ICFGR_WORDS(spi_cfg->num_spis); i++) {
+		spi_cfg->icfgr[i] = 0U;
+	}
+
+	for (i = 0U; i < spi_cfg->num_spis; i++) {
+		spi_cfg->ipriorityr[i] = GIC_HIGHEST_NS_PRIORITY;
+		spi_cfg->itargetsr[i] = 0U;
+	}
+
+	for (i = 0U; i < driver_data->interrupt_props_num; i++) {
+		prop_desc = &driver_data->interrupt_props[i];
+
+		if (prop_desc->intr_num < MIN_SPI_ID)
+			continue;
+
+		assert(prop_desc->intr_grp == GICV2_INTR_GROUP0);
+
+		rc = gicv2_spi_cfg_set_secure(spi_cfg, prop_desc->intr_num,
+				prop_desc->intr_pri, prop_desc->intr_cfg,
+				gicv2_get_cpuif_id(driver_data->gicd_base));
+		assert(rc == 0);
+	}
+}
+
+/*******************************************************************************
+ * Record in SPI register images that interrupt 'id' is a secure, enabled SPI
+ * with the given priority, configuration and target CPU mask. Returns -1 if
+ * the SPI is not covered by the images.
+ ******************************************************************************/
+int gicv2_spi_cfg_set_secure(gicv2_spi_cfg_t *spi_cfg, unsigned int id,
+			     unsigned int pri, unsigned int cfg,
+			     unsigned int target)
+{
+	unsigned int n, shift;
+
+	assert(spi_cfg != NULL);
+
+	if ((id < MIN_SPI_ID) || ((id - MIN_SPI_ID) >= spi_cfg->num_spis)) {
+		return -1;
+	}
+
+	n = id - MIN_SPI_ID;
+
+	spi_cfg->igroupr[n >> IGROUPR_SHIFT] &=
+		~BIT_32(n & ((1U << IGROUPR_SHIFT) - 1U));
+	spi_cfg->isenabler[n >> ISENABLER_SHIFT] |=
+		BIT_32(n & ((1U << ISENABLER_SHIFT) - 1U));
+
+	shift = (n & ((1U << ICFGR_SHIFT) - 1U)) << 1;
+	spi_cfg->icfgr[n >> ICFGR_SHIFT] &= ~(GIC_CFG_MASK << shift);
+	spi_cfg->icfgr[n >> ICFGR_SHIFT] |= (cfg & GIC_CFG_MASK) << shift;
+
+	spi_cfg->ipriorityr[n] = (uint8_t)(pri & GIC_PRI_MASK);
+	spi_cfg->itargetsr[n] = (uint8_t)(target & GIC_TARGET_CPU_MASK);
+
+	return 0;
+}
+
+/*******************************************************************************
+ * Program the distributor for interrupt 'id' from SPI register images, once
+ * the distributor is running. Only the group register is written as a whole,
+ * as the non-secure world can't modify it; other registers are accessed per
+ * interrupt so as not to clobber non-secure settings.
+ ******************************************************************************/
+void gicv2_spi_cfg_apply_one(const gicv2_spi_cfg_t *spi_cfg, unsigned int id)
+{
+	unsigned int n, shift;
+
+	assert(driver_data != NULL);
+	assert(driver_data->gicd_base != 0U);
+	assert(spi_cfg != NULL);
+	assert((id >= MIN_SPI_ID) && ((id - MIN_SPI_ID) < spi_cfg->num_spis));
+
+	n = id - MIN_SPI_ID;
+	shift = (n & ((1U << ICFGR_SHIFT) - 1U)) << 1;
+
+	spin_lock(&gic_lock);
+	gicd_write_igroupr(driver_data->gicd_base, id,
+			   spi_cfg->igroupr[n >> IGROUPR_SHIFT]);
+	gicd_set_ipriorityr(driver_data->gicd_base, id,
+			    spi_cfg->ipriorityr[n]);
+	gicd_set_itargetsr(driver_data->gicd_base, id, spi_cfg->itargetsr[n]);
+	gicd_set_icfgr(driver_data->gicd_base, id,
+		       (spi_cfg->icfgr[n >> ICFGR_SHIFT] >> shift) &
+		       GIC_CFG_MASK);
+	spin_unlock(&gic_lock);
+
+	if ((spi_cfg->isenabler[n >> ISENABLER_SHIFT] &
+	     BIT_32(n & ((1U << ISENABLER_SHIFT) - 1U))) != 0U) {
+		gicd_set_isenabler(driver_data->gicd_base, id);
+	}
+}
+
 /*******************************************************************************
  * Initialize the ARM GICv2 driver with the provided platform inputs
  ******************************************************************************/
@@ -156,6 +294,13 @@ void gicv2_driver_init(const gicv2_driver_data_t *plat_driver_data)
 
 	driver_data = plat_driver_data;
 
+	/*
+	 * Compute once the SGI/PPI configuration that every CPU programs on
+	 * cold boot and hotplug.
+	 */
+	gicv2_secure_ppi_sgi_build_cfg(driver_data->interrupt_props,
+			driver_data->interrupt_props_num, &pcpu_cfg);
+
 	/*
 	 * The GIC driver data is initialized by the primary CPU with caches
 	 * enabled. When the secondary CPU boots up, it initializes the
@@ -167,6 +312,7 @@ void gicv2_driver_init(const gicv2_driver_data_t *plat_driver_data)
 #if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
 	flush_dcache_range((uintptr_t) &driver_data, sizeof(driver_data));
 	flush_dcache_range((uintptr_t) driver_data, sizeof(*driver_data));
+	flush_dcache_range((uintptr_t) &pcpu_cfg, sizeof(pcpu_cfg));
 #endif
 	INFO("ARM GICv2 driver initialized\n");
 }
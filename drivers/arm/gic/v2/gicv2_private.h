@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2020, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -12,6 +12,18 @@
 #include <drivers/arm/gicv2.h>
 #include <lib/mmio.h>
 
+/*******************************************************************************
+ * Register images of the secure SGI/PPI configuration, computed once by the
+ * primary CPU and programmed by each CPU in its banked distributor registers.
+ ******************************************************************************/
+typedef struct gicv2_pcpu_cfg {
+	uint32_t igroupr;
+	uint32_t isenabler;
+	uint32_t icfgr_mask;
+	uint32_t icfgr;
+	uint32_t ipriorityr[TOTAL_PCPU_INTR_NUM >> IPRIORITYR_SHIFT];
+} gicv2_pcpu_cfg_t;
+
 /*******************************************************************************
  * Private function prototypes
  ******************************************************************************/
@@ -19,9 +31,11 @@ void gicv2_spis_configure_defaults(uintptr_t gicd_base);
 void gicv2_secure_spis_configure_props(uintptr_t gicd_base,
 		const interrupt_prop_t *interrupt_props,
 		unsigned int interrupt_props_num);
-void gicv2_secure_ppi_sgi_setup_props(uintptr_t gicd_base,
-		const interrupt_prop_t *interrupt_props,
-		unsigned int interrupt_props_num);
+void gicv2_secure_ppi_sgi_build_cfg(const interrupt_prop_t *interrupt_props,
+		unsigned int interrupt_props_num, gicv2_pcpu_cfg_t *cfg);
+void gicv2_secure_ppi_sgi_apply_cfg(uintptr_t gicd_base,
+		const gicv2_pcpu_cfg_t *cfg);
+void gicv2_spis_apply_cfg(uintptr_t gicd_base, const gicv2_spi_cfg_t *cfg);
 unsigned int gicv2_get_cpuif_id(uintptr_t base);
 
 /*******************************************************************************
@@ -5,6 +5,7 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -21,6 +22,7 @@
 
 /* ASN.1 tags */
 #define ASN1_INTEGER                 0x02
+#define ASN1_SEQUENCE                0x30
 
 #define return_if_error(rc) \
 	do { \
@@ -32,6 +34,34 @@
 #pragma weak plat_set_nv_ctr2
 #pragma weak plat_get_hashed_pk
 
+#ifdef IMAGE_BL1
+/*
+ * Image data hashed incrementally as it is written to its final location, see
+ * auth_mod_stream_start().
+ */
+static struct {
+	unsigned int img_id;
+	uintptr_t base;
+	unsigned int len;
+	bool active;
+} hash_stream;
+#endif
+
+/*
+ * Chunks of an image verified in order by auth_mod_verify_chunk(), so that the
+ * image does not need to be hashed again when it is authenticated as a whole.
+ */
+static struct {
+	unsigned int img_id;
+	uintptr_t base;
+	unsigned int len;
+	unsigned int num;
+	/* Start of the hash list, and the hashes of the chunks left */
+	const unsigned char *list;
+	unsigned char *hashes;
+	unsigned int hashes_len;
+	bool active;
+} chunk_stream;
 
 static int cmp_auth_param_type_desc(const auth_param_type_desc_t *a,
 		const auth_param_type_desc_t *b)
@@ -111,6 +141,22 @@ static int auth_hash(const auth_method_param_hash_t *param,
 			img, img_len, &data_ptr, &data_len);
 	return_if_error(rc);
 
+#ifdef IMAGE_BL1
+	/*
+	 * Use the hash calculated while the image was written, if it covers
+	 * exactly the data to be hashed.
+	 */
+	if (hash_stream.active && (hash_stream.img_id == img_desc->img_id) &&
+	    (hash_stream.base == (uintptr_t)data_ptr) &&
+	    (hash_stream.len == data_len)) {
+		hash_stream.active = false;
+		rc = crypto_mod_hash_stream_verify(hash_der_ptr, hash_der_len);
+		if (rc != CRYPTO_ERR_UNKNOWN) {
+			return rc;
+		}
+	}
+#endif
+
 	/* Ask the crypto module to verify this hash */
 	rc = crypto_mod_verify_hash(data_ptr, data_len,
 				    hash_der_ptr, hash_der_len);
@@ -118,6 +164,179 @@ static int auth_hash(const auth_method_param_hash_t *param,
 	return rc;
 }
 
+/*
+ * Read the header of a DER encoded element with the expected tag. On success,
+ * '*p' points to the element content and '*len' is its length.
+ */
+static int der_get_elem(unsigned char **p, const unsigned char *end,
+			unsigned char tag, unsigned int *len)
+{
+	unsigned char *q = *p;
+	unsigned int n;
+
+	if (((end - q) < 2) || (*q++ != tag)) {
+		return 1;
+	}
+
+	if ((*q & 0x80) == 0) {
+		*len = *q++;
+	} else {
+		n = *q++ & 0x7f;
+		if ((n == 0) || (n > 4) || ((unsigned int)(end - q) < n)) {
+			return 1;
+		}
+		*len = 0;
+		while (n-- != 0) {
+			*len = (*len << 8) | *q++;
+		}
+	}
+
+	if (*len > (unsigned int)(end - q)) {
+		return 1;
+	}
+
+	*p = q;
+	return 0;
+}
+
+/*
+ * Parse a list of chunk hashes, DER encoded as:
+ *
+ * HashList ::= SEQUENCE {
+ *     chunkSize        INTEGER,
+ *     chunkHashes      SEQUENCE OF DigestInfo
+ * }
+ *
+ * On success, '*hashes' points to the first DigestInfo and '*hashes_len' is
+ * the length of the whole sequence of them.
+ */
+static int hash_list_parse(void *list_ptr, unsigned int list_len,
+			   unsigned int *chunk_size, unsigned char **hashes,
+			   unsigned int *hashes_len)
+{
+	unsigned char *p = list_ptr;
+	unsigned char *end = p + list_len;
+	unsigned int len, i;
+
+	if ((der_get_elem(&p, end, ASN1_SEQUENCE, &len) != 0) ||
+	    (der_get_elem(&p, end, ASN1_INTEGER, &len) != 0)) {
+		return 1;
+	}
+
+	/* Chunk sizes are positive integers up to 32-bit */
+	if ((len == 0) || (len > 5) || ((p[0] & 0x80) != 0) ||
+	    ((len == 5) && (p[0] != 0))) {
+		return 1;
+	}
+
+	*chunk_size = 0;
+	for (i = 0; i < len; i++) {
+		*chunk_size = (*chunk_size << 8) | *p++;
+	}
+
+	if ((*chunk_size == 0) ||
+	    (der_get_elem(&p, end, ASN1_SEQUENCE, hashes_len) != 0)) {
+		return 1;
+	}
+
+	*hashes = p;
+	return 0;
+}
+
+/*
+ * Return the next DigestInfo of a list of chunk hashes, including its header,
+ * as expected by crypto_mod_verify_hash()
+ */
+static int hash_list_next(unsigned char **hashes, unsigned int *hashes_len,
+			  void **hash_der_ptr, unsigned int *hash_der_len)
+{
+	unsigned char *p = *hashes;
+	unsigned int len;
+
+	if (der_get_elem(&p, *hashes + *hashes_len, ASN1_SEQUENCE,
+			 &len) != 0) {
+		return 1;
+	}
+
+	len += (unsigned int)(p - *hashes);
+
+	*hash_der_ptr = *hashes;
+	*hash_der_len = len;
+	*hashes += len;
+	*hashes_len -= len;
+
+	return 0;
+}
+
+/*
+ * Authenticate an image by matching the hashes of its successive chunks
+ *
+ * This function implements 'AUTH_METHOD_HASH_LIST'. The parent image must
+ * contain a list of hashes, one for each chunk of the data to authenticate.
+ * All chunks have the size given in the list, but the last one that may be
+ * shorter. The image is rejected as soon as one chunk does not match.
+ *
+ * If all the chunks of the image have already been verified in order while it
+ * was loaded, see auth_mod_verify_chunk(), they are not hashed again.
+ *
+ * Return: 0 = success, Otherwise = error
+ */
+static int auth_hash_list(const auth_method_param_hash_list_t *param,
+			  const auth_img_desc_t *img_desc,
+			  void *img, unsigned int img_len)
+{
+	void *data_ptr, *list_ptr, *hash_der_ptr;
+	unsigned int data_len, list_len, hash_der_len;
+	unsigned int chunk_size, hashes_len, num, len;
+	unsigned char *hashes, *p;
+	int rc = 0;
+
+	/* Get the list of chunk hashes from the parent image */
+	rc = auth_get_param(param->hash_list, img_desc->parent,
+			&list_ptr, &list_len);
+	return_if_error(rc);
+
+	rc = hash_list_parse(list_ptr, list_len, &chunk_size, &hashes,
+			     &hashes_len);
+	return_if_error(rc);
+
+	/* Get the data to be hashed from the current image */
+	rc = img_parser_get_auth_param(img_desc->img_type, param->data,
+			img, img_len, &data_ptr, &data_len);
+	return_if_error(rc);
+
+	num = (data_len / chunk_size) + (((data_len % chunk_size) != 0U) ?
+					 1U : 0U);
+
+	if (chunk_stream.active && (chunk_stream.img_id == img_desc->img_id) &&
+	    (chunk_stream.list == hashes) &&
+	    (chunk_stream.base == (uintptr_t)data_ptr) &&
+	    (chunk_stream.len == data_len) && (chunk_stream.num == num)) {
+		chunk_stream.active = false;
+		/* Check there is no hash left for a missing chunk */
+		return (chunk_stream.hashes_len == 0U) ? 0 : 1;
+	}
+
+	/* Ask the crypto module to verify the hash of each chunk */
+	p = data_ptr;
+	while (data_len != 0U) {
+		len = (data_len < chunk_size) ? data_len : chunk_size;
+
+		rc = hash_list_next(&hashes, &hashes_len,
+				    &hash_der_ptr, &hash_der_len);
+		return_if_error(rc);
+
+		rc = crypto_mod_verify_hash(p, len, hash_der_ptr, hash_der_len);
+		return_if_error(rc);
+
+		p += len;
+		data_len -= len;
+	}
+
+	/* Each hash must match a chunk */
+	return (hashes_len == 0U) ? 0 : 1;
+}
+
 /*
  * Authenticate by digital signature
  *
@@ -336,6 +555,239 @@ int auth_mod_get_parent_id(unsigned int img_id, unsigned int *parent_id)
 	return 0;
 }
 
+/*
+ * Return the hash an image is authenticated against, as extracted from its
+ * authenticated parent: a DER encoded DigestInfo structure. It allows an image
+ * that is not loaded by this BL image to be verified later by its user.
+ *
+ * Return: 0 = success, Otherwise = the image is not authenticated by hash, or
+ * its parent is not authenticated yet
+ */
+int auth_mod_get_img_hash(unsigned int img_id, void **hash_ptr,
+			  unsigned int *hash_len)
+{
+	const auth_img_desc_t *img_desc = NULL;
+	unsigned int i;
+
+	assert((hash_ptr != NULL) && (hash_len != NULL));
+	img_desc = FCONF_GET_PROPERTY(tbbr, cot, img_id);
+
+	if ((img_desc->parent == NULL) ||
+	    ((auth_img_flags[img_desc->parent->img_id] &
+	      IMG_FLAG_AUTHENTICATED) == 0U)) {
+		return 1;
+	}
+
+	for (i = 0U; i < AUTH_METHOD_NUM; i++) {
+		const auth_method_desc_t *auth_method =
+			&img_desc->img_auth_methods[i];
+
+		if (auth_method->type == AUTH_METHOD_HASH) {
+			return auth_get_param(auth_method->param.hash.hash,
+					      img_desc->parent, hash_ptr,
+					      hash_len);
+		}
+	}
+
+	return 1;
+}
+
+#ifdef IMAGE_BL1
+/*
+ * Start hashing an image incrementally, as its blocks are written to their
+ * final location starting at 'img_ptr'. Only one image can be hashed this way
+ * at a time: the hash of a previous image, e.g. one left over by an image
+ * authenticated by signature only, is discarded.
+ *
+ * Return: 0 = success, Otherwise = the crypto library does not support it
+ */
+int auth_mod_stream_start(unsigned int img_id, void *img_ptr)
+{
+	hash_stream.active = false;
+
+	if (crypto_mod_hash_stream_start() != CRYPTO_SUCCESS) {
+		return 1;
+	}
+
+	hash_stream.img_id = img_id;
+	hash_stream.base = (uintptr_t)img_ptr;
+	hash_stream.len = 0U;
+	hash_stream.active = true;
+
+	return 0;
+}
+
+/*
+ * Add the next block of an image to its incremental hash. Blocks must be
+ * contiguous, otherwise the hash is discarded and the image will be hashed in
+ * one go at authentication time.
+ */
+void auth_mod_stream_update(unsigned int img_id, const void *data_ptr,
+			    unsigned int data_len)
+{
+	if (!hash_stream.active || (hash_stream.img_id != img_id)) {
+		return;
+	}
+
+	if (((hash_stream.base + hash_stream.len) != (uintptr_t)data_ptr) ||
+	    (crypto_mod_hash_stream_update(data_ptr, data_len) !=
+	     CRYPTO_SUCCESS)) {
+		hash_stream.active = false;
+		return;
+	}
+
+	hash_stream.len += data_len;
+}
+
+/*
+ * Discard the incremental hash of an image, if any
+ */
+void auth_mod_stream_abort(unsigned int img_id)
+{
+	if (hash_stream.img_id == img_id) {
+		hash_stream.active = false;
+	}
+}
+#endif /* IMAGE_BL1 */
+
+/*
+ * Return the list of chunk hashes an image is authenticated against, as
+ * extracted from its authenticated parent
+ */
+static int auth_get_hash_list(unsigned int img_id,
+			      unsigned int *chunk_size, unsigned char **hashes,
+			      unsigned int *hashes_len)
+{
+	const auth_img_desc_t *img_desc = NULL;
+	void *list_ptr;
+	unsigned int list_len, i;
+	int rc;
+
+	img_desc = FCONF_GET_PROPERTY(tbbr, cot, img_id);
+
+	if ((img_desc->img_auth_methods == NULL) ||
+	    (img_desc->parent == NULL) ||
+	    ((auth_img_flags[img_desc->parent->img_id] &
+	      IMG_FLAG_AUTHENTICATED) == 0U)) {
+		return 1;
+	}
+
+	for (i = 0U; i < AUTH_METHOD_NUM; i++) {
+		const auth_method_desc_t *auth_method =
+			&img_desc->img_auth_methods[i];
+
+		if (auth_method->type == AUTH_METHOD_HASH_LIST) {
+			rc = auth_get_param(auth_method->param.hash_list.hash_list,
+					    img_desc->parent, &list_ptr,
+					    &list_len);
+			return_if_error(rc);
+
+			return hash_list_parse(list_ptr, list_len, chunk_size,
+					       hashes, hashes_len);
+		}
+	}
+
+	return 1;
+}
+
+/*
+ * Return the size of the chunks of an image that can be verified one by one
+ * with auth_mod_verify_chunk(), as soon as they are loaded.
+ *
+ * Return: 0 = success, Otherwise = the image is not authenticated by a list
+ * of chunk hashes, or its parent is not authenticated yet
+ */
+int auth_mod_get_chunk_size(unsigned int img_id, unsigned int *chunk_size)
+{
+	unsigned char *hashes;
+	unsigned int hashes_len;
+
+	assert(chunk_size != NULL);
+
+	return auth_get_hash_list(img_id, chunk_size, &hashes, &hashes_len);
+}
+
+/*
+ * Verify chunk 'idx' of an image against the list of chunk hashes of its
+ * authenticated parent. All chunks have the size returned by
+ * auth_mod_get_chunk_size() but the last one, that may be shorter. This may be
+ * used while an image is loaded, to stop at the first corrupted chunk, or
+ * later to check a part of the image before using it.
+ *
+ * When all the chunks of an image are verified in order from the first one,
+ * the image is not hashed again by auth_mod_verify_img().
+ *
+ * Return: 0 = success, Otherwise = error
+ */
+int auth_mod_verify_chunk(unsigned int img_id, unsigned int idx,
+			  void *chunk_ptr, unsigned int chunk_len)
+{
+	void *hash_der_ptr = NULL;
+	unsigned int chunk_size, hashes_len, hash_der_len, skip, i;
+	unsigned char *hashes, *list;
+	int rc;
+
+	rc = auth_get_hash_list(img_id, &chunk_size, &hashes, &hashes_len);
+	return_if_error(rc);
+
+	if ((chunk_len == 0U) || (chunk_len > chunk_size)) {
+		return 1;
+	}
+
+	list = hashes;
+
+	/* Resume after the previous chunk rather than walk the list again */
+	if ((idx != 0U) && chunk_stream.active &&
+	    (chunk_stream.img_id == img_id) && (chunk_stream.list == list) &&
+	    (chunk_stream.num == idx)) {
+		hashes = chunk_stream.hashes;
+		hashes_len = chunk_stream.hashes_len;
+		skip = 0U;
+	} else {
+		skip = idx;
+	}
+
+	for (i = 0U; i <= skip; i++) {
+		rc = hash_list_next(&hashes, &hashes_len,
+				    &hash_der_ptr, &hash_der_len);
+		return_if_error(rc);
+	}
+
+	/* Only the last chunk may be shorter */
+	if ((chunk_len != chunk_size) && (hashes_len != 0U)) {
+		return 1;
+	}
+
+	rc = crypto_mod_verify_hash(chunk_ptr, chunk_len,
+				    hash_der_ptr, hash_der_len);
+	if (rc != 0) {
+		chunk_stream.active = false;
+		return rc;
+	}
+
+	if (idx == 0U) {
+		chunk_stream.img_id = img_id;
+		chunk_stream.base = (uintptr_t)chunk_ptr;
+		chunk_stream.len = 0U;
+		chunk_stream.num = 0U;
+		chunk_stream.list = list;
+		chunk_stream.active = true;
+	} else if (!chunk_stream.active || (chunk_stream.img_id != img_id) ||
+		   (chunk_stream.num != idx) ||
+		   ((chunk_stream.base + chunk_stream.len) !=
+		    (uintptr_t)chunk_ptr)) {
+		chunk_stream.active = false;
+		return 0;
+	}
+
+	chunk_stream.len += chunk_len;
+	chunk_stream.num++;
+	chunk_stream.hashes = hashes;
+	chunk_stream.hashes_len = hashes_len;
+
+	return 0;
+}
+
 /*
  * Initialize the different modules in the authentication framework
  */
@@ -395,6 +847,10 @@ int auth_mod_verify_img(unsigned int img_id,
 			rc = auth_nvctr(&auth_method->param.nv_ctr,
 					img_desc, img_ptr, img_len);
 			break;
+		case AUTH_METHOD_HASH_LIST:
+			rc = auth_hash_list(&auth_method->param.hash_list,
+					img_desc, img_ptr, img_len);
+			break;
 		default:
 			/* Unknown authentication method */
 			rc = 1;
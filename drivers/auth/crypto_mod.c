@@ -11,6 +11,11 @@
 
 /* Variable exported by the crypto library through REGISTER_CRYPTO_LIB() */
 
+#ifdef IMAGE_BL1
+/* Incremental hashing is optional, see REGISTER_CRYPTO_HASH_STREAM() */
+#pragma weak crypto_hash_stream_desc
+#endif
+
 /*
  * The crypto module is responsible for verifying digital signatures and hashes.
  * It relies on a crypto library to perform the cryptographic operations.
@@ -104,6 +109,62 @@ int crypto_mod_verify_hash(void *data_ptr, unsigned int data_len,
 					   digest_info_ptr, digest_info_len);
 }
 
+#ifdef IMAGE_BL1
+/*
+ * Start an incremental hash calculation
+ *
+ * Returns CRYPTO_ERR_UNKNOWN if the library does not support it.
+ */
+int crypto_mod_hash_stream_start(void)
+{
+	if (&crypto_hash_stream_desc == NULL) {
+		return CRYPTO_ERR_UNKNOWN;
+	}
+
+	return crypto_hash_stream_desc.start();
+}
+
+/*
+ * Add data to an incremental hash calculation
+ *
+ * Parameters:
+ *
+ *   data_ptr, data_len: next block of data to be hashed
+ */
+int crypto_mod_hash_stream_update(const void *data_ptr, unsigned int data_len)
+{
+	assert(data_ptr != NULL);
+	assert(data_len != 0);
+
+	if (&crypto_hash_stream_desc == NULL) {
+		return CRYPTO_ERR_UNKNOWN;
+	}
+
+	return crypto_hash_stream_desc.update(data_ptr, data_len);
+}
+
+/*
+ * Finalize an incremental hash calculation and verify it by comparison
+ *
+ * Parameters:
+ *
+ *   digest_info_ptr, digest_info_len: hash to be compared
+ */
+int crypto_mod_hash_stream_verify(void *digest_info_ptr,
+				  unsigned int digest_info_len)
+{
+	assert(digest_info_ptr != NULL);
+	assert(digest_info_len != 0);
+
+	if (&crypto_hash_stream_desc == NULL) {
+		return CRYPTO_ERR_UNKNOWN;
+	}
+
+	return crypto_hash_stream_desc.verify(digest_info_ptr,
+					      digest_info_len);
+}
+#endif /* IMAGE_BL1 */
+
 #if MEASURED_BOOT
 /*
  * Calculate a hash
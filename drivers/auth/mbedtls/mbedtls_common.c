@@ -50,6 +50,9 @@ void mbedtls_init(void)
 
 #ifdef MBEDTLS_PLATFORM_SNPRINTF_ALT
 		mbedtls_platform_set_snprintf(snprintf);
+#endif
+#if TF_MBEDTLS_SHA_NEON
+		mbedtls_sha_neon_self_test();
 #endif
 		ready = 1;
 	}
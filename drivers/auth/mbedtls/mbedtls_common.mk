@@ -21,6 +21,16 @@ $(eval $(call add_define,MBEDTLS_CONFIG_FILE))
 
 MBEDTLS_SOURCES	+=		drivers/auth/mbedtls/mbedtls_common.c
 
+# Use the NEON SHA-512 block function, AArch32 with NEON only
+TF_MBEDTLS_SHA_NEON	?=	0
+ifeq (${TF_MBEDTLS_SHA_NEON},1)
+    ifneq (${ARCH}-${ARM_WITH_NEON},aarch32-yes)
+        $(error "TF_MBEDTLS_SHA_NEON requires ARCH=aarch32 and ARM_WITH_NEON=yes")
+    endif
+MBEDTLS_SOURCES	+=		drivers/auth/mbedtls/aarch32/sha512_neon.S	\
+				drivers/auth/mbedtls/mbedtls_sha_neon.c
+endif
+
 
 LIBMBEDTLS_SRCS		:= $(addprefix ${MBEDTLS_DIR}/library/,	\
 					aes.c 					\
@@ -102,6 +112,7 @@ $(eval $(call add_defines,\
         TF_MBEDTLS_KEY_ALG_ID \
         TF_MBEDTLS_KEY_SIZE \
         TF_MBEDTLS_HASH_ALG_ID \
+        TF_MBEDTLS_SHA_NEON \
         TF_MBEDTLS_USE_AES_GCM \
 )))
 
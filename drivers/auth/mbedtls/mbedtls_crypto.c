@@ -5,6 +5,7 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <string.h>
 
@@ -140,19 +141,15 @@ end2:
 }
 
 /*
- * Match a hash
- *
- * Digest info is passed in DER format following the ASN.1 structure detailed
- * above.
+ * Extract the digest algorithm and value from a DER encoded digest info
  */
-static int verify_hash(void *data_ptr, unsigned int data_len,
-		       void *digest_info_ptr, unsigned int digest_info_len)
+static int get_digest_info(void *digest_info_ptr, unsigned int digest_info_len,
+			   const mbedtls_md_info_t **md_info,
+			   unsigned char **hash)
 {
 	mbedtls_asn1_buf hash_oid, params;
 	mbedtls_md_type_t md_alg;
-	const mbedtls_md_info_t *md_info;
-	unsigned char *p, *end, *hash;
-	unsigned char data_hash[MBEDTLS_MD_MAX_SIZE];
+	unsigned char *p, *end;
 	size_t len;
 	int rc;
 
@@ -176,8 +173,8 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 		return CRYPTO_ERR_HASH;
 	}
 
-	md_info = mbedtls_md_info_from_type(md_alg);
-	if (md_info == NULL) {
+	*md_info = mbedtls_md_info_from_type(md_alg);
+	if (*md_info == NULL) {
 		return CRYPTO_ERR_HASH;
 	}
 
@@ -188,14 +185,35 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 	}
 
 	/* Length of hash must match the algorithm's size */
-	if (len != mbedtls_md_get_size(md_info)) {
+	if (len != mbedtls_md_get_size(*md_info)) {
 		return CRYPTO_ERR_HASH;
 	}
-	hash = p;
+	*hash = p;
+
+	return CRYPTO_SUCCESS;
+}
+
+/*
+ * Match a hash
+ *
+ * Digest info is passed in DER format following the ASN.1 structure detailed
+ * above.
+ */
+static int verify_hash(void *data_ptr, unsigned int data_len,
+		       void *digest_info_ptr, unsigned int digest_info_len)
+{
+	const mbedtls_md_info_t *md_info;
+	unsigned char *hash;
+	unsigned char data_hash[MBEDTLS_MD_MAX_SIZE];
+	int rc;
+
+	rc = get_digest_info(digest_info_ptr, digest_info_len, &md_info, &hash);
+	if (rc != 0) {
+		return rc;
+	}
 
 	/* Calculate the hash of the data */
-	p = (unsigned char *)data_ptr;
-	rc = mbedtls_md(md_info, p, data_len, data_hash);
+	rc = mbedtls_md(md_info, data_ptr, data_len, data_hash);
 	if (rc != 0) {
 		return CRYPTO_ERR_HASH;
 	}
@@ -209,6 +227,108 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 	return CRYPTO_SUCCESS;
 }
 
+#ifdef IMAGE_BL1
+/*
+ * Incremental hash calculation. Blocks are hashed with the algorithm selected
+ * at build time through TF_MBEDTLS_HASH_ALG_ID, which is the one the chain of
+ * trust is expected to use.
+ */
+#if TF_MBEDTLS_HASH_ALG_ID == TF_MBEDTLS_SHA512
+#define HASH_STREAM_MD_TYPE	MBEDTLS_MD_SHA512
+#elif TF_MBEDTLS_HASH_ALG_ID == TF_MBEDTLS_SHA384
+#define HASH_STREAM_MD_TYPE	MBEDTLS_MD_SHA384
+#else
+#define HASH_STREAM_MD_TYPE	MBEDTLS_MD_SHA256
+#endif
+
+static mbedtls_md_context_t hash_stream_ctx;
+static bool hash_stream_active;
+
+static void hash_stream_end(void)
+{
+	if (hash_stream_active) {
+		mbedtls_md_free(&hash_stream_ctx);
+		hash_stream_active = false;
+	}
+}
+
+static int hash_stream_start(void)
+{
+	int rc;
+
+	hash_stream_end();
+
+	mbedtls_md_init(&hash_stream_ctx);
+	rc = mbedtls_md_setup(&hash_stream_ctx,
+			      mbedtls_md_info_from_type(HASH_STREAM_MD_TYPE),
+			      0);
+	if (rc == 0) {
+		rc = mbedtls_md_starts(&hash_stream_ctx);
+	}
+
+	if (rc != 0) {
+		mbedtls_md_free(&hash_stream_ctx);
+		return CRYPTO_ERR_HASH;
+	}
+
+	hash_stream_active = true;
+
+	return CRYPTO_SUCCESS;
+}
+
+static int hash_stream_update(const void *data_ptr, unsigned int data_len)
+{
+	if (!hash_stream_active) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	if (mbedtls_md_update(&hash_stream_ctx, data_ptr, data_len) != 0) {
+		hash_stream_end();
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+
+static int hash_stream_verify(void *digest_info_ptr,
+			      unsigned int digest_info_len)
+{
+	const mbedtls_md_info_t *md_info;
+	unsigned char *hash;
+	unsigned char data_hash[MBEDTLS_MD_MAX_SIZE];
+	int rc;
+
+	if (!hash_stream_active) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	rc = get_digest_info(digest_info_ptr, digest_info_len, &md_info, &hash);
+	if (rc != 0) {
+		hash_stream_end();
+		return rc;
+	}
+
+	if (mbedtls_md_get_type(md_info) != HASH_STREAM_MD_TYPE) {
+		hash_stream_end();
+		return CRYPTO_ERR_UNKNOWN;
+	}
+
+	rc = mbedtls_md_finish(&hash_stream_ctx, data_hash);
+	hash_stream_end();
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	/* Compare values */
+	rc = memcmp(data_hash, hash, mbedtls_md_get_size(md_info));
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+#endif /* IMAGE_BL1 */
+
 #if MEASURED_BOOT
 /*
  * Calculate a hash
@@ -348,3 +468,8 @@ REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash,
 REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, NULL);
 #endif
 #endif /* MEASURED_BOOT */
+
+#ifdef IMAGE_BL1
+REGISTER_CRYPTO_HASH_STREAM(hash_stream_start, hash_stream_update,
+			    hash_stream_verify);
+#endif
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+/* mbed TLS headers */
+#include <mbedtls/sha512.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <drivers/auth/mbedtls/mbedtls_common.h>
+#include <plat/common/platform.h>
+
+/*
+ * mbed TLS SHA-512 block function using the Advanced SIMD unit: the 64-bit
+ * arithmetic of SHA-512 and SHA-384 runs on the NEON lanes. SHA-256 keeps the
+ * mbed TLS C code.
+ */
+
+void sha512_block_neon(uint64_t state[8], const uint8_t data[128]);
+
+#if defined(MBEDTLS_SHA512_C)
+#if defined(MBEDTLS_SHA512_PROCESS_ALT)
+int mbedtls_internal_sha512_process(mbedtls_sha512_context *ctx,
+				    const unsigned char data[128])
+{
+	sha512_block_neon(ctx->state, data);
+
+	return 0;
+}
+#endif /* MBEDTLS_SHA512_PROCESS_ALT */
+
+/*
+ * Known-answer tests from the FIPS 180-4 examples: "abc" in one block and
+ * the 896-bit message in two blocks.
+ */
+static const char sha512_kat_msg1[] = "abc";
+
+static const char sha512_kat_msg2[] =
+	"abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+	"hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+
+static const uint8_t sha512_kat_digest[2][64] = {
+	{
+		0xdd, 0xaf, 0x35, 0xa1, 0x93, 0x61, 0x7a, 0xba,
+		0xcc, 0x41, 0x73, 0x49, 0xae, 0x20, 0x41, 0x31,
+		0x12, 0xe6, 0xfa, 0x4e, 0x89, 0xa9, 0x7e, 0xa2,
+		0x0a, 0x9e, 0xee, 0xe6, 0x4b, 0x55, 0xd3, 0x9a,
+		0x21, 0x92, 0x99, 0x2a, 0x27, 0x4f, 0xc1, 0xa8,
+		0x36, 0xba, 0x3c, 0x23, 0xa3, 0xfe, 0xeb, 0xbd,
+		0x45, 0x4d, 0x44, 0x23, 0x64, 0x3c, 0xe8, 0x0e,
+		0x2a, 0x9a, 0xc9, 0x4f, 0xa5, 0x4c, 0xa4, 0x9f,
+	},
+	{
+		0x8e, 0x95, 0x9b, 0x75, 0xda, 0xe3, 0x13, 0xda,
+		0x8c, 0xf4, 0xf7, 0x28, 0x14, 0xfc, 0x14, 0x3f,
+		0x8f, 0x77, 0x79, 0xc6, 0xeb, 0x9f, 0x7f, 0xa1,
+		0x72, 0x99, 0xae, 0xad, 0xb6, 0x88, 0x90, 0x18,
+		0x50, 0x1d, 0x28, 0x9e, 0x49, 0x00, 0xf7, 0xe4,
+		0x33, 0x1b, 0x99, 0xde, 0xc4, 0xb5, 0x43, 0x3a,
+		0xc7, 0xd3, 0x29, 0xee, 0xb6, 0xdd, 0x26, 0x54,
+		0x5e, 0x96, 0xe5, 0x5b, 0x87, 0x4b, 0xe9, 0x09,
+	},
+};
+
+#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+/* Blocks hashed by each block function to compare their throughput */
+#define SHA_NEON_BENCH_BLOCKS	64U
+
+#define ROTR64(_x, _n)		(((_x) >> (_n)) | ((_x) << (64 - (_n))))
+
+#define SHA512_S0(_x)		(ROTR64(_x, 28) ^ ROTR64(_x, 34) ^ ROTR64(_x, 39))
+#define SHA512_S1(_x)		(ROTR64(_x, 14) ^ ROTR64(_x, 18) ^ ROTR64(_x, 41))
+#define SHA512_G0(_x)		(ROTR64(_x, 1) ^ ROTR64(_x, 8) ^ ((_x) >> 7))
+#define SHA512_G1(_x)		(ROTR64(_x, 19) ^ ROTR64(_x, 61) ^ ((_x) >> 6))
+#define SHA512_CH(_x, _y, _z)	((_z) ^ ((_x) & ((_y) ^ (_z))))
+#define SHA512_MAJ(_x, _y, _z)	(((_x) & (_y)) | ((_z) & ((_x) | (_y))))
+
+/* Round constants of sha512_neon.S */
+extern const uint64_t sha512_k[80];
+
+/* Portable C block function, the reference of the NEON one */
+static void sha512_block_c(uint64_t state[8], const uint8_t data[128])
+{
+	uint64_t w[80];
+	uint64_t s[8];
+	unsigned int i;
+	unsigned int j;
+
+	for (i = 0U; i < 16U; i++) {
+		w[i] = 0U;
+		for (j = 0U; j < 8U; j++) {
+			w[i] = (w[i] << 8) | data[(i * 8U) + j];
+		}
+	}
+
+	for (i = 16U; i < 80U; i++) {
+		w[i] = SHA512_G1(w[i - 2U]) + w[i - 7U] +
+		       SHA512_G0(w[i - 15U]) + w[i - 16U];
+	}
+
+	for (i = 0U; i < 8U; i++) {
+		s[i] = state[i];
+	}
+
+	for (i = 0U; i < 80U; i++) {
+		uint64_t t1 = s[7] + SHA512_S1(s[4]) +
+			      SHA512_CH(s[4], s[5], s[6]) + sha512_k[i] + w[i];
+		uint64_t t2 = SHA512_S0(s[0]) + SHA512_MAJ(s[0], s[1], s[2]);
+
+		s[7] = s[6];
+		s[6] = s[5];
+		s[5] = s[4];
+		s[4] = s[3] + t1;
+		s[3] = s[2];
+		s[2] = s[1];
+		s[1] = s[0];
+		s[0] = t1 + t2;
+	}
+
+	for (i = 0U; i < 8U; i++) {
+		state[i] += s[i];
+	}
+}
+
+static uint64_t sha_neon_bench_us(uint64_t start, u_register_t freq)
+{
+	return ((read_cntpct_el0() - start) * 1000000ULL) / freq;
+}
+
+/*
+ * Hash the same blocks with the NEON and the C block functions, and print
+ * the time each one takes. Their results must match.
+ */
+static void sha_neon_bench(void)
+{
+	u_register_t freq = read_cntfrq_el0();
+	uint64_t state_neon[8] = { 0U };
+	uint64_t state_c[8] = { 0U };
+	uint8_t buf[128];
+	uint64_t start;
+	uint64_t neon_us;
+	uint64_t c_us;
+	unsigned int n;
+
+	if (freq == 0U) {
+		return;
+	}
+
+	memset(buf, 0x5a, sizeof(buf));
+
+	start = read_cntpct_el0();
+	for (n = 0U; n < SHA_NEON_BENCH_BLOCKS; n++) {
+		sha512_block_neon(state_neon, buf);
+	}
+	neon_us = sha_neon_bench_us(start, freq);
+
+	start = read_cntpct_el0();
+	for (n = 0U; n < SHA_NEON_BENCH_BLOCKS; n++) {
+		sha512_block_c(state_c, buf);
+	}
+	c_us = sha_neon_bench_us(start, freq);
+
+	if (memcmp(state_neon, state_c, sizeof(state_c)) != 0) {
+		ERROR("SHA-512 NEON and C block functions differ\n");
+		panic();
+	}
+
+	VERBOSE("SHA-512: %u bytes hashed in %llu us with NEON, %llu us in C\n",
+		SHA_NEON_BENCH_BLOCKS * (unsigned int)sizeof(buf),
+		neon_us, c_us);
+}
+#endif /* LOG_LEVEL >= LOG_LEVEL_VERBOSE */
+#endif /* MBEDTLS_SHA512_C */
+
+/*
+ * Check the NEON block function against the FIPS 180-4 examples before
+ * mbed TLS relies on it. A mismatch is fatal: no image could be
+ * authenticated with a wrong hash.
+ */
+void mbedtls_sha_neon_self_test(void)
+{
+#if defined(MBEDTLS_SHA512_C)
+	unsigned char digest[64];
+
+	if ((mbedtls_sha512_ret((const unsigned char *)sha512_kat_msg1,
+				sizeof(sha512_kat_msg1) - 1U, digest, 0) != 0) ||
+	    (memcmp(digest, sha512_kat_digest[0], 64U) != 0) ||
+	    (mbedtls_sha512_ret((const unsigned char *)sha512_kat_msg2,
+				sizeof(sha512_kat_msg2) - 1U, digest, 0) != 0) ||
+	    (memcmp(digest, sha512_kat_digest[1], 64U) != 0)) {
+		ERROR("SHA-512 NEON self-test failed\n");
+		panic();
+	}
+
+#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+	sha_neon_bench();
+#endif
+#endif /* MBEDTLS_SHA512_C */
+}
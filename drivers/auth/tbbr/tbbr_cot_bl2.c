@@ -30,6 +30,16 @@ static unsigned char nt_fw_config_hash_buf[HASH_DER_LEN];
 #if defined(SPD_spmd)
 static unsigned char sp_pkg_hash_buf[MAX_SP_IDS][HASH_DER_LEN];
 #endif /* SPD_spmd */
+#if NT_FW_HASH_CHUNK_SIZE != 0
+/* Maximum number of BL33 chunks hashed separately */
+#ifndef PLAT_NT_FW_MAX_HASH_CHUNKS
+#define PLAT_NT_FW_MAX_HASH_CHUNKS	32
+#endif
+/* Two SEQUENCE headers and the chunk size INTEGER precede the hashes */
+#define NT_WORLD_BL_HASH_LIST_LEN	\
+	(16 + (PLAT_NT_FW_MAX_HASH_CHUNKS * HASH_DER_LEN))
+static unsigned char nt_world_bl_hash_list_buf[NT_WORLD_BL_HASH_LIST_LEN];
+#endif /* NT_FW_HASH_CHUNK_SIZE != 0 */
 
 static auth_param_type_desc_t non_trusted_nv_ctr = AUTH_PARAM_TYPE_DESC(
 		AUTH_PARAM_NV_CTR, NON_TRUSTED_FW_NVCOUNTER_OID);
@@ -63,6 +73,10 @@ static auth_param_type_desc_t nt_world_bl_hash = AUTH_PARAM_TYPE_DESC(
 		AUTH_PARAM_HASH, NON_TRUSTED_WORLD_BOOTLOADER_HASH_OID);
 static auth_param_type_desc_t nt_fw_config_hash = AUTH_PARAM_TYPE_DESC(
 		AUTH_PARAM_HASH, NON_TRUSTED_FW_CONFIG_HASH_OID);
+#if NT_FW_HASH_CHUNK_SIZE != 0
+static auth_param_type_desc_t nt_world_bl_hash_list = AUTH_PARAM_TYPE_DESC(
+		AUTH_PARAM_HASH, NON_TRUSTED_WORLD_BOOTLOADER_CHUNK_HASHES_OID);
+#endif
 #if defined(SPD_spmd)
 static auth_param_type_desc_t sp_pkg1_hash = AUTH_PARAM_TYPE_DESC(
 		AUTH_PARAM_HASH, SP_PKG1_HASH_OID);
@@ -524,7 +538,16 @@ static const auth_img_desc_t non_trusted_fw_content_cert = {
 				.ptr = (void *)nt_fw_config_hash_buf,
 				.len = (unsigned int)HASH_DER_LEN
 			}
+		},
+#if NT_FW_HASH_CHUNK_SIZE != 0
+		[2] = {
+			.type_desc = &nt_world_bl_hash_list,
+			.data = {
+				.ptr = (void *)nt_world_bl_hash_list_buf,
+				.len = (unsigned int)NT_WORLD_BL_HASH_LIST_LEN
+			}
 		}
+#endif
 	}
 };
 static const auth_img_desc_t bl33_image = {
@@ -532,6 +555,15 @@ static const auth_img_desc_t bl33_image = {
 	.img_type = IMG_RAW,
 	.parent = &non_trusted_fw_content_cert,
 	.img_auth_methods = (const auth_method_desc_t[AUTH_METHOD_NUM]) {
+#if NT_FW_HASH_CHUNK_SIZE != 0
+		[0] = {
+			.type = AUTH_METHOD_HASH_LIST,
+			.param.hash_list = {
+				.data = &raw_data,
+				.hash_list = &nt_world_bl_hash_list
+			}
+		}
+#else
 		[0] = {
 			.type = AUTH_METHOD_HASH,
 			.param.hash = {
@@ -539,6 +571,7 @@ static const auth_img_desc_t bl33_image = {
 				.hash = &nt_world_bl_hash
 			}
 		}
+#endif
 	}
 };
 /* NT FW Config */
@@ -34,10 +34,16 @@ void udelay(uint32_t usec)
 
 	start = timer_ops->get_timer_value();
 
-	/* Add an extra tick to avoid delaying less than requested. */
-	total_delta =
-		div_round_up((uint64_t)usec * timer_ops->clk_div,
-						timer_ops->clk_mult) + 1U;
+	/*
+	 * Add an extra tick to avoid delaying less than requested. The
+	 * division is skipped when the timer ticks a whole number of times
+	 * per microsecond, as the generic delay timer does at whole MHz.
+	 */
+	total_delta = (uint64_t)usec * timer_ops->clk_div;
+	if (timer_ops->clk_mult != 1U) {
+		total_delta = div_round_up(total_delta, timer_ops->clk_mult);
+	}
+	total_delta += 1U;
 	/*
 	 * Precaution for the total_delta ~ UINT32_MAX and the fact that we
 	 * cannot catch every tick of the timer.
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2020, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <drivers/dma.h>
+
+#define BENCH_MIN_LEN		256U
+
+static const dma_ops_t *ops;
+
+static void dma_cpu_xfer(dma_xfer_t *xfer)
+{
+	if (xfer->fill) {
+		memset((void *)xfer->dst, xfer->value, xfer->len);
+	} else {
+		memcpy((void *)xfer->dst, (const void *)xfer->src, xfer->len);
+	}
+
+	xfer->chan = -1;
+}
+
+static void dma_start(dma_xfer_t *xfer)
+{
+	int chan = -ENODEV;
+
+	if ((ops != NULL) && (xfer->len >= ops->min_len)) {
+		if (!xfer->fill) {
+			flush_dcache_range(xfer->src, xfer->len);
+		}
+
+		/* No dirty line must be evicted over the transferred data */
+		flush_dcache_range(xfer->dst, xfer->len);
+
+		if (xfer->fill) {
+			chan = ops->fill(xfer->dst, xfer->value, xfer->len);
+		} else {
+			chan = ops->copy(xfer->dst, xfer->src, xfer->len);
+		}
+	}
+
+	if (chan < 0) {
+		dma_cpu_xfer(xfer);
+		return;
+	}
+
+	xfer->chan = chan;
+}
+
+void dma_memcpy_async(dma_xfer_t *xfer, void *dst, const void *src,
+		      size_t len)
+{
+	assert(xfer != NULL);
+
+	xfer->dst = (uintptr_t)dst;
+	xfer->src = (uintptr_t)src;
+	xfer->len = len;
+	xfer->fill = false;
+
+	dma_start(xfer);
+}
+
+void dma_memset_async(dma_xfer_t *xfer, void *dst, int value, size_t len)
+{
+	assert(xfer != NULL);
+
+	xfer->dst = (uintptr_t)dst;
+	xfer->src = 0U;
+	xfer->len = len;
+	xfer->value = (uint8_t)value;
+	xfer->fill = true;
+
+	dma_start(xfer);
+}
+
+/*
+ * Wait for a transfer started with dma_memcpy_async() or dma_memset_async().
+ * A transfer the engine fails is done again by the CPU.
+ */
+void dma_wait(dma_xfer_t *xfer)
+{
+	int ret;
+
+	assert(xfer != NULL);
+
+	if (xfer->chan < 0) {
+		return;
+	}
+
+	ret = ops->wait(xfer->chan);
+
+	/* Drop lines speculatively loaded during the transfer */
+	inv_dcache_range(xfer->dst, xfer->len);
+
+	if (ret != 0) {
+		WARN("DMA: transfer error %d, done by the CPU\n", ret);
+		dma_cpu_xfer(xfer);
+	}
+
+	xfer->chan = -1;
+}
+
+void *dma_memcpy(void *dst, const void *src, size_t len)
+{
+	dma_xfer_t xfer;
+
+	dma_memcpy_async(&xfer, dst, src, len);
+	dma_wait(&xfer);
+
+	return dst;
+}
+
+void *dma_memset(void *dst, int value, size_t len)
+{
+	dma_xfer_t xfer;
+
+	dma_memset_async(&xfer, dst, value, len);
+	dma_wait(&xfer);
+
+	return dst;
+}
+
+static unsigned long bench_rate_mbs(bool use_dma, uintptr_t dst,
+				    uintptr_t src, size_t len,
+				    unsigned int count)
+{
+	uint64_t start = read_cntpct_el0();
+	uint64_t ticks;
+	unsigned int i;
+
+	for (i = 0U; i < count; i++) {
+		if (use_dma) {
+			dma_memcpy((void *)dst, (const void *)src, len);
+		} else {
+			memcpy((void *)dst, (const void *)src, len);
+		}
+	}
+
+	ticks = read_cntpct_el0() - start;
+	if (ticks == 0U) {
+		ticks = 1U;
+	}
+
+	return (unsigned long)(((uint64_t)len * count * read_cntfrq_el0()) /
+			       (ticks * 1000000ULL));
+}
+
+/*
+ * Compare dma_memcpy(), cache maintenance included, with the CPU memcpy()
+ * from 256 bytes up to half the scratch area. Each size copies about half
+ * the scratch area. The whole area is overwritten.
+ */
+void dma_benchmark(uintptr_t scratch, size_t size)
+{
+	uintptr_t src = scratch;
+	uintptr_t dst = scratch + (size / 2U);
+	size_t len;
+
+	memset((void *)src, 0x5A, size / 2U);
+
+	for (len = BENCH_MIN_LEN; len <= (size / 2U); len *= 4U) {
+		unsigned int count = (unsigned int)((size / 2U) / len);
+		unsigned long cpu = bench_rate_mbs(false, dst, src, len, count);
+		unsigned long dma = bench_rate_mbs(true, dst, src, len, count);
+
+		NOTICE("DMA: %8lu bytes x %5u: memcpy %4lu MB/s, dma %4lu MB/s\n",
+		       (unsigned long)len, count, cpu, dma);
+	}
+}
+
+/*
+ * Register the DMA engine. Without one, transfers are all done by the CPU.
+ */
+void dma_register(const dma_ops_t *ops_ptr)
+{
+	assert((ops_ptr != NULL) && (ops_ptr->copy != NULL) &&
+	       (ops_ptr->fill != NULL) && (ops_ptr->wait != NULL));
+
+	ops = ops_ptr;
+}
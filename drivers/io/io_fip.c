@@ -6,6 +6,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -25,6 +26,14 @@
 #define MAX_FIP_DEVICES		1
 #endif
 
+/*
+ * Number of ToC entries kept while the FIP device is initialised, so that
+ * opening a file found earlier in the ToC does not read it again.
+ */
+#ifndef PLAT_FIP_TOC_CACHE_ENTRIES
+#define PLAT_FIP_TOC_CACHE_ENTRIES	0
+#endif
+
 /* Useful for printing UUIDs when debugging.*/
 #define PRINT_UUID2(x)								\
 	"%08x-%04hx-%04hx-%02hhx%02hhx-%02hhx%02hhx%02hhx%02hhx%02hhx%02hhx",	\
@@ -47,6 +56,13 @@ typedef struct {
 typedef struct {
 	uintptr_t dev_spec;
 	uint16_t plat_toc_flag;
+#if PLAT_FIP_TOC_CACHE_ENTRIES
+	/* First ToC entries of the FIP backend, in ToC order */
+	fip_toc_entry_t toc_cache[PLAT_FIP_TOC_CACHE_ENTRIES];
+	unsigned int toc_cache_count;
+	/* All the ToC entries are in the cache */
+	bool toc_cache_complete;
+#endif
 } fip_dev_state_t;
 
 /*
@@ -181,6 +197,67 @@ static int free_dev_info(io_dev_info_t *dev_info)
 	return result;
 }
 
+static void toc_cache_reset(fip_dev_state_t *state)
+{
+#if PLAT_FIP_TOC_CACHE_ENTRIES
+	state->toc_cache_count = 0U;
+	state->toc_cache_complete = false;
+#endif
+}
+
+/*
+ * Look for a file in the cached ToC entries. Return 0 and fill entry if it
+ * is found, -ENOENT if the FIP does not hold it, and -EAGAIN if the ToC
+ * must be read from the backend, after the *toc_index cached entries.
+ */
+static int toc_cache_find(const fip_dev_state_t *state, const uuid_t *uuid,
+			  fip_toc_entry_t *entry, unsigned int *toc_index)
+{
+#if PLAT_FIP_TOC_CACHE_ENTRIES
+	unsigned int i;
+
+	for (i = 0U; i < state->toc_cache_count; i++) {
+		if (compare_uuids(&state->toc_cache[i].uuid, uuid) == 0) {
+			*entry = state->toc_cache[i];
+			return 0;
+		}
+	}
+
+	if (state->toc_cache_complete) {
+		return -ENOENT;
+	}
+
+	*toc_index = state->toc_cache_count;
+#else
+	*toc_index = 0U;
+#endif
+
+	return -EAGAIN;
+}
+
+/* Record the ToC entry read from the backend at position toc_index */
+static void toc_cache_add(fip_dev_state_t *state,
+			  const fip_toc_entry_t *entry, unsigned int toc_index)
+{
+#if PLAT_FIP_TOC_CACHE_ENTRIES
+	static const uuid_t uuid_null = { {0} }; /* Double braces for clang */
+
+	if (toc_index != state->toc_cache_count) {
+		return;
+	}
+
+	if (compare_uuids(&entry->uuid, &uuid_null) == 0) {
+		state->toc_cache_complete = true;
+		return;
+	}
+
+	if (state->toc_cache_count < PLAT_FIP_TOC_CACHE_ENTRIES) {
+		state->toc_cache[state->toc_cache_count] = *entry;
+		state->toc_cache_count++;
+	}
+#endif
+}
+
 /*
  * Multiple FIP devices can be opened depending on the value of
  * MAX_FIP_DEVICES. Given that there is only one backend, only a
@@ -226,6 +303,8 @@ static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 
 	state = (fip_dev_state_t *)dev_info->info;
 
+	toc_cache_reset(state);
+
 	/* Obtain a reference to the image by querying the platform layer */
 	result = plat_get_image_source(image_id, &backend_dev_handle,
 				       &backend_image_spec);
@@ -276,6 +355,8 @@ static int fip_dev_close(io_dev_info_t *dev_info)
 	backend_dev_handle = (uintptr_t)NULL;
 	backend_image_spec = (uintptr_t)NULL;
 
+	toc_cache_reset((fip_dev_state_t *)dev_info->info);
+
 	return free_dev_info(dev_info);
 }
 
@@ -290,10 +371,15 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 	static const uuid_t uuid_null = { {0} }; /* Double braces for clang */
 	size_t bytes_read;
 	int found_file = 0;
+	unsigned int toc_index;
+	fip_dev_state_t *state;
 
+	assert(dev_info != NULL);
 	assert(uuid_spec != NULL);
 	assert(entity != NULL);
 
+	state = (fip_dev_state_t *)dev_info->info;
+
 	/* Can only have one file open at a time for the moment. We need to
 	 * track state like file cursor position. We know the header lives at
 	 * offset zero, so this entry should never be zero for an active file.
@@ -305,6 +391,17 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 		return -ENFILE;
 	}
 
+	result = toc_cache_find(state, &uuid_spec->uuid,
+				&current_fip_file.entry, &toc_index);
+	if (result == 0) {
+		current_fip_file.file_pos = 0;
+		entity->info = (uintptr_t)&current_fip_file;
+		goto fip_file_open_exit;
+	} else if (result == -ENOENT) {
+		current_fip_file.entry.offset_address = 0;
+		goto fip_file_open_exit;
+	}
+
 	/* Attempt to access the FIP image */
 	result = io_open(backend_dev_handle, backend_image_spec,
 			 &backend_handle);
@@ -314,9 +411,14 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 		goto fip_file_open_exit;
 	}
 
-	/* Seek past the FIP header into the Table of Contents */
+	/*
+	 * Seek past the FIP header and the cached entries into the Table of
+	 * Contents
+	 */
 	result = io_seek(backend_handle, IO_SEEK_SET,
-			 (signed long long)sizeof(fip_toc_header_t));
+			 (signed long long)(sizeof(fip_toc_header_t) +
+					    (toc_index *
+					     sizeof(fip_toc_entry_t))));
 	if (result != 0) {
 		WARN("fip_file_open: failed to seek\n");
 		result = -ENOENT;
@@ -330,6 +432,10 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 				 sizeof(current_fip_file.entry),
 				 &bytes_read);
 		if (result == 0) {
+			toc_cache_add(state, &current_fip_file.entry,
+				      toc_index);
+			toc_index++;
+
 			if (compare_uuids(&current_fip_file.entry.uuid,
 					  &uuid_spec->uuid) == 0) {
 				found_file = 1;
@@ -479,3 +585,20 @@ int fip_dev_get_plat_toc_flag(io_dev_info_t *dev_info, uint16_t *plat_toc_flag)
 
 	return 0;
 }
+
+/* Function to retrieve the offset in the package of a file opened from it */
+int fip_file_get_offset(uintptr_t handle, size_t *offset)
+{
+	const io_entity_t *entity = (io_entity_t *)handle;
+
+	assert(entity != NULL);
+	assert(offset != NULL);
+
+	if (entity->dev_handle->funcs != &fip_dev_funcs) {
+		return -ENODEV;
+	}
+
+	*offset = ((fip_file_state_t *)entity->info)->entry.offset_address;
+
+	return 0;
+}
@@ -5,6 +5,7 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stddef.h>
 
 #include <platform_def.h>
@@ -28,6 +29,23 @@ static const io_dev_info_t *devices[MAX_IO_DEVICES];
 /* Number of currently registered devices */
 static unsigned int dev_count;
 
+/*
+ * Device connections kept across several image loads by an IO session:
+ * a device is only initialised once with given parameters and its closure
+ * is deferred to the end of the session.
+ */
+typedef struct {
+	const io_dev_info_t *dev;
+	uintptr_t init_params;
+	bool init_done;
+	bool close_pending;
+} io_session_dev_t;
+
+static io_session_dev_t session_devs[MAX_IO_DEVICES];
+static bool session_active;
+
+static io_stats_t stats;
+
 /* Extra validation functions only used when asserts are enabled */
 #if ENABLE_ASSERTIONS
 
@@ -139,6 +157,44 @@ static int free_entity(const io_entity_t *entity)
 }
 
 
+/* Return the session entry of a device, allocating it if needed */
+static io_session_dev_t *session_get_dev(const io_dev_info_t *dev)
+{
+	io_session_dev_t *free_entry = NULL;
+
+	for (unsigned int index = 0; index < MAX_IO_DEVICES; ++index) {
+		if (session_devs[index].dev == dev) {
+			return &session_devs[index];
+		}
+
+		if ((free_entry == NULL) && (session_devs[index].dev == NULL)) {
+			free_entry = &session_devs[index];
+		}
+	}
+
+	if (free_entry != NULL) {
+		free_entry->dev = dev;
+		free_entry->init_done = false;
+		free_entry->close_pending = false;
+	}
+
+	return free_entry;
+}
+
+
+static int dev_close(io_dev_info_t *dev)
+{
+	/* Absence of registered function implies NOP here */
+	if (dev->funcs->dev_close == NULL) {
+		return 0;
+	}
+
+	stats.dev_close++;
+
+	return dev->funcs->dev_close(dev);
+}
+
+
 /* Exported API */
 
 /* Register a device driver */
@@ -175,30 +231,106 @@ int io_dev_init(uintptr_t dev_handle, const uintptr_t init_params)
 	assert(is_valid_dev(dev_handle));
 
 	io_dev_info_t *dev = (io_dev_info_t *)dev_handle;
+	io_session_dev_t *session_dev = NULL;
+
+	if (session_active) {
+		session_dev = session_get_dev(dev);
+		if ((session_dev != NULL) && session_dev->init_done &&
+		    (session_dev->init_params == init_params)) {
+			return 0;
+		}
+
+		/* Re-initialisation: do the deferred closure first */
+		if ((session_dev != NULL) && session_dev->close_pending) {
+			(void)dev_close(dev);
+			session_dev->close_pending = false;
+		}
+	}
 
 	/* Absence of registered function implies NOP here */
 	if (dev->funcs->dev_init != NULL) {
+		stats.dev_init++;
 		result = dev->funcs->dev_init(dev, init_params);
 	}
 
+	if (session_dev != NULL) {
+		session_dev->init_params = init_params;
+		session_dev->init_done = (result == 0);
+	}
+
 	return result;
 }
 
 /* Close a connection to a device */
 int io_dev_close(uintptr_t dev_handle)
 {
-	int result = 0;
 	assert(dev_handle != (uintptr_t)NULL);
 	assert(is_valid_dev(dev_handle));
 
 	io_dev_info_t *dev = (io_dev_info_t *)dev_handle;
 
-	/* Absence of registered function implies NOP here */
-	if (dev->funcs->dev_close != NULL) {
-		result = dev->funcs->dev_close(dev);
+	if (session_active) {
+		io_session_dev_t *session_dev = session_get_dev(dev);
+
+		if (session_dev != NULL) {
+			session_dev->close_pending = true;
+			return 0;
+		}
 	}
 
-	return result;
+	return dev_close(dev);
+}
+
+
+/* Start keeping device connections open across image loads */
+void io_session_begin(void)
+{
+	assert(!session_active);
+
+	session_active = true;
+}
+
+
+/*
+ * Close the device connections whose closure was deferred by the session and
+ * forget the initialisation state of all devices.
+ */
+void io_session_end(void)
+{
+	assert(session_active);
+
+	session_active = false;
+
+	for (unsigned int index = 0; index < MAX_IO_DEVICES; ++index) {
+		io_session_dev_t *session_dev = &session_devs[index];
+
+		if ((session_dev->dev != NULL) && session_dev->close_pending) {
+			/* Ignore improbable/unrecoverable error in 'close' */
+			(void)dev_close((io_dev_info_t *)session_dev->dev);
+		}
+
+		session_dev->dev = NULL;
+	}
+}
+
+
+/*
+ * Re-initialise the devices on their next use, e.g. when the platform
+ * switches to another boot source.
+ */
+void io_session_flush(void)
+{
+	if (session_active) {
+		io_session_end();
+		io_session_begin();
+	}
+}
+
+
+/* Return the IO counters accumulated since boot */
+const io_stats_t *io_get_stats(void)
+{
+	return &stats;
 }
 
 
@@ -219,6 +351,7 @@ int io_open(uintptr_t dev_handle, const uintptr_t spec, uintptr_t *handle)
 
 	if (result == 0) {
 		assert(dev->funcs->open != NULL);
+		stats.open++;
 		result = dev->funcs->open(dev, spec, entity);
 
 		if (result == 0) {
@@ -278,9 +411,17 @@ int io_read(uintptr_t handle,
 
 	io_dev_info_t *dev = entity->dev_handle;
 
-	if (dev->funcs->read != NULL)
+	if (dev->funcs->read != NULL) {
+		io_type_t type = dev->funcs->type();
+
 		result = dev->funcs->read(entity, buffer, length, length_read);
 
+		stats.read[type]++;
+		if (result == 0) {
+			stats.read_bytes[type] += *length_read;
+		}
+	}
+
 	return result;
 }
 
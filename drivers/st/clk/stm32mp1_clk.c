@@ -448,8 +448,9 @@ static const struct stm32mp1_clk_gate stm32mp1_clk_gate[] = {
 	_CLK_SC_SELEC(SEC, RCC_MP_AHB5ENSETR, 6, RNG1_K, _RNG1_SEL),
 	_CLK_SC_FIXED(SEC, RCC_MP_AHB5ENSETR, 8, BKPSRAM, _PCLK5),
 
-#if defined(IMAGE_BL32)
 	_CLK_SC_FIXED(SEC, RCC_MP_TZAHB6ENSETR, 0, MDMA, _ACLK),
+
+#if defined(IMAGE_BL32)
 	_CLK_SC_SELEC(N_S, RCC_MP_AHB6ENSETR, 5, GPU, _UNKNOWN_SEL),
 	_CLK_SC_FIXED(N_S, RCC_MP_AHB6ENSETR, 10, ETHMAC, _ACLK),
 #endif
@@ -705,6 +706,30 @@ static uint32_t mpapb_iwdg1;
 static uint32_t mpapb_iwdg2;
 #endif
 
+#if defined(IMAGE_BL32)
+/*
+ * Shadow of the RCC state only the secure world can write once RCC_TZCR
+ * is set, so that runtime clock queries are served from memory. Entries
+ * are filled on first read and dropped right after the secure world
+ * writes the related registers. A zero rate is an empty entry.
+ */
+static const uint16_t rcc_shadow_gate_offset[] = {
+	RCC_MP_APB5ENSETR,
+	RCC_MP_AHB5ENSETR,
+	RCC_MP_TZAHB6ENSETR,
+};
+
+static struct rcc_shadow {
+	unsigned int gen;
+	bool tzcr_valid;
+	uint32_t tzcr;
+	uint32_t gate_valid;
+	uint32_t gate[ARRAY_SIZE(rcc_shadow_gate_offset)];
+	unsigned long rate[_PARENT_NB];
+} rcc_shadow;
+static struct spinlock shadow_lock;
+#endif
+
 static const struct stm32mp1_clk_gate *gate_ref(unsigned int idx)
 {
 	return &stm32mp1_clk_gate[idx];
@@ -740,20 +765,101 @@ static void stm32mp1_clk_unlock(struct spinlock *lock)
 	}
 }
 
+static void rcc_shadow_flush_gates(void)
+{
+#if defined(IMAGE_BL32)
+	stm32mp1_clk_lock(&shadow_lock);
+	rcc_shadow.gate_valid = 0U;
+	stm32mp1_clk_unlock(&shadow_lock);
+#endif
+}
+
+static void rcc_shadow_flush(void)
+{
+#if defined(IMAGE_BL32)
+	unsigned int i;
+
+	stm32mp1_clk_lock(&shadow_lock);
+
+	rcc_shadow.gen++;
+	rcc_shadow.tzcr_valid = false;
+	rcc_shadow.gate_valid = 0U;
+	for (i = 0U; i < ARRAY_SIZE(rcc_shadow.rate); i++) {
+		rcc_shadow.rate[i] = 0UL;
+	}
+
+	stm32mp1_clk_unlock(&shadow_lock);
+#endif
+}
+
+static uint32_t rcc_read_tzcr(void)
+{
+	uintptr_t address = stm32mp_rcc_base() + RCC_TZCR;
+#if defined(IMAGE_BL32)
+	uint32_t value;
+
+	stm32mp1_clk_lock(&shadow_lock);
+
+	if (!rcc_shadow.tzcr_valid) {
+		rcc_shadow.tzcr = mmio_read_32(address);
+		rcc_shadow.tzcr_valid = true;
+	}
+	value = rcc_shadow.tzcr;
+
+	stm32mp1_clk_unlock(&shadow_lock);
+
+	return value;
+#else
+	return mmio_read_32(address);
+#endif
+}
+
 bool stm32mp1_rcc_is_secure(void)
 {
-	uintptr_t rcc_base = stm32mp_rcc_base();
 	uint32_t mask = RCC_TZCR_TZEN;
 
-	return (mmio_read_32(rcc_base + RCC_TZCR) & mask) == mask;
+	return (rcc_read_tzcr() & mask) == mask;
 }
 
 bool stm32mp1_rcc_is_mckprot(void)
 {
-	uintptr_t rcc_base = stm32mp_rcc_base();
 	uint32_t mask = RCC_TZCR_TZEN | RCC_TZCR_MCKPROT;
 
-	return (mmio_read_32(rcc_base + RCC_TZCR) & mask) == mask;
+	return (rcc_read_tzcr() & mask) == mask;
+}
+
+static uint32_t rcc_read_gate(uint16_t offset)
+{
+	uintptr_t address = stm32mp_rcc_base() + offset;
+#if defined(IMAGE_BL32)
+	unsigned int i;
+	uint32_t value;
+
+	for (i = 0U; i < ARRAY_SIZE(rcc_shadow_gate_offset); i++) {
+		if (rcc_shadow_gate_offset[i] == offset) {
+			break;
+		}
+	}
+
+	if ((i == ARRAY_SIZE(rcc_shadow_gate_offset)) ||
+	    !stm32mp1_rcc_is_secure()) {
+		return mmio_read_32(address);
+	}
+
+	stm32mp1_clk_lock(&shadow_lock);
+
+	if ((rcc_shadow.gate_valid & BIT(i)) == 0U) {
+		rcc_shadow.gate[i] = mmio_read_32(address);
+		rcc_shadow.gate_valid |= BIT(i);
+	}
+	value = rcc_shadow.gate[i];
+
+	stm32mp1_clk_unlock(&shadow_lock);
+
+	return value;
+#else
+	return mmio_read_32(address);
+#endif
 }
 
 void stm32mp1_clk_rcc_regs_lock(void)
@@ -918,7 +1024,7 @@ static unsigned long stm32mp1_read_pll_freq(enum stm32mp1_pll_id pll_id,
 	return dfout;
 }
 
-static unsigned long get_clock_rate(int p)
+static unsigned long read_clock_rate(int p)
 {
 	uint32_t reg, clkdiv;
 	unsigned long clock = 0;
@@ -1117,6 +1223,80 @@ static unsigned long get_clock_rate(int p)
 	return clock;
 }
 
+#if defined(IMAGE_BL32)
+/* Rates derived only from registers the non-secure world cannot write */
+static bool clock_rate_is_shadowed(int p)
+{
+	switch (p) {
+	case _CK_MPU:
+	case _ACLK:
+	case _HCLK2:
+	case _HCLK6:
+	case _PCLK4:
+	case _PCLK5:
+	case _PLL1_P:
+	case _PLL1_Q:
+	case _PLL1_R:
+	case _PLL2_P:
+	case _PLL2_Q:
+	case _PLL2_R:
+		return stm32mp1_rcc_is_secure();
+	case _CK_MCU:
+	case _PCLK1:
+	case _PCLK2:
+	case _PCLK3:
+	case _PLL3_P:
+	case _PLL3_Q:
+	case _PLL3_R:
+		return stm32mp1_rcc_is_mckprot();
+	default:
+		return false;
+	}
+}
+
+/* The non-secure world cannot change the rate of a secure clock @id */
+bool stm32mp1_clk_rate_is_secure(unsigned long id)
+{
+	int p = stm32mp1_clk_get_parent(id);
+
+	return (p >= 0) && clock_rate_is_shadowed(p);
+}
+#endif
+
+static unsigned long get_clock_rate(int p)
+{
+#if defined(IMAGE_BL32)
+	unsigned long clock;
+	unsigned int gen;
+
+	stm32mp1_clk_lock(&shadow_lock);
+	clock = rcc_shadow.rate[p];
+	gen = rcc_shadow.gen;
+	stm32mp1_clk_unlock(&shadow_lock);
+
+	if (clock != 0UL) {
+		return clock;
+	}
+
+	clock = read_clock_rate(p);
+
+	if (!clock_rate_is_shadowed(p)) {
+		return clock;
+	}
+
+	/* Drop the value if the RCC was written while it was computed */
+	stm32mp1_clk_lock(&shadow_lock);
+	if (rcc_shadow.gen == gen) {
+		rcc_shadow.rate[p] = clock;
+	}
+	stm32mp1_clk_unlock(&shadow_lock);
+
+	return clock;
+#else
+	return read_clock_rate(p);
+#endif
+}
+
 static void __clk_enable(struct stm32mp1_clk_gate const *gate)
 {
 	uintptr_t rcc_base = stm32mp_rcc_base();
@@ -1128,6 +1308,8 @@ static void __clk_enable(struct stm32mp1_clk_gate const *gate)
 	} else {
 		mmio_setbits_32(rcc_base + gate->offset, BIT(gate->bit));
 	}
+
+	rcc_shadow_flush_gates();
 }
 
 static void __clk_disable(struct stm32mp1_clk_gate const *gate)
@@ -1142,13 +1324,13 @@ static void __clk_disable(struct stm32mp1_clk_gate const *gate)
 	} else {
 		mmio_clrbits_32(rcc_base + gate->offset, BIT(gate->bit));
 	}
+
+	rcc_shadow_flush_gates();
 }
 
 static bool __clk_is_enabled(struct stm32mp1_clk_gate const *gate)
 {
-	uintptr_t rcc_base = stm32mp_rcc_base();
-
-	return mmio_read_32(rcc_base + gate->offset) & BIT(gate->bit);
+	return (rcc_read_gate(gate->offset) & BIT(gate->bit)) != 0U;
 }
 
 /* Oscillators and PLLs are not gated at runtime */
@@ -1448,7 +1630,7 @@ static void stm32mp1_lsi_set(bool enable)
 	}
 }
 
-static void stm32mp1_hse_enable(bool bypass, bool digbyp, bool css)
+static void stm32mp1_hse_enable(bool bypass, bool digbyp)
 {
 	uintptr_t rcc_base = stm32mp_rcc_base();
 
@@ -1461,9 +1643,22 @@ static void stm32mp1_hse_enable(bool bypass, bool digbyp, bool css)
 	}
 
 	stm32mp1_hs_ocs_set(true, RCC_OCENR_HSEON);
-	if (stm32mp1_osc_wait(true, RCC_OCRDYR, RCC_OCRDYR_HSERDY) != 0) {
+}
+
+/*
+ * Wait for the high speed oscillators started with stm32mp1_hse_enable()
+ * and/or stm32mp1_csi_enable(): all are polled against a single timeout.
+ */
+static void stm32mp1_hs_osc_wait(uint32_t mask_rdy)
+{
+	if (stm32mp1_osc_wait(true, RCC_OCRDYR, mask_rdy) != 0) {
 		VERBOSE("%s: failed\n", __func__);
 	}
+}
+
+static void stm32mp1_hse_css(bool bypass, bool digbyp, bool css)
+{
+	uintptr_t rcc_base = stm32mp_rcc_base();
 
 	if (css) {
 		mmio_write_32(rcc_base + RCC_OCENSETR, RCC_OCENR_HSECSSON);
@@ -1477,12 +1672,9 @@ static void stm32mp1_hse_enable(bool bypass, bool digbyp, bool css)
 #endif
 }
 
-static void stm32mp1_csi_set(bool enable)
+static void stm32mp1_csi_enable(void)
 {
-	stm32mp1_hs_ocs_set(enable, RCC_OCENR_CSION);
-	if (stm32mp1_osc_wait(enable, RCC_OCRDYR, RCC_OCRDYR_CSIRDY) != 0) {
-		VERBOSE("%s: failed\n", __func__);
-	}
+	stm32mp1_hs_ocs_set(true, RCC_OCENR_CSION);
 }
 
 static void stm32mp1_hsi_set(bool enable)
@@ -1648,6 +1840,53 @@ static int stm32mp1_pll_output(enum stm32mp1_pll_id pll_id, uint32_t output)
 	return 0;
 }
 
+/*
+ * Wait lock of all the PLLs set in pll_mask (bit i for PLL i) against a
+ * single timeout, and start the requested outputs of each PLL as soon as
+ * it is locked. The PLLs must have been started with stm32mp1_pll_start().
+ */
+static int stm32mp1_pll_wait_output(uint32_t pll_mask,
+				    unsigned int pllcfg[_PLL_NB][PLLCFG_NB])
+{
+	uintptr_t rcc_base = stm32mp_rcc_base();
+	uint64_t timeout = timeout_init_us(PLLRDY_TIMEOUT);
+	enum stm32mp1_pll_id i;
+
+	while (pll_mask != 0U) {
+		for (i = (enum stm32mp1_pll_id)0; i < _PLL_NB; i++) {
+			uintptr_t pllxcr = rcc_base + pll_ref(i)->pllxcr;
+
+			if ((pll_mask & BIT(i)) == 0U) {
+				continue;
+			}
+
+			if ((mmio_read_32(pllxcr) & RCC_PLLNCR_PLLRDY) == 0U) {
+				continue;
+			}
+
+			mmio_setbits_32(pllxcr, pllcfg[i][PLLCFG_O] <<
+					RCC_PLLNCR_DIVEN_SHIFT);
+			pll_mask &= ~BIT(i);
+		}
+
+		if ((pll_mask != 0U) && timeout_elapsed(timeout)) {
+			for (i = (enum stm32mp1_pll_id)0; i < _PLL_NB; i++) {
+				if ((pll_mask & BIT(i)) != 0U) {
+					uintptr_t pllxcr = rcc_base +
+							   pll_ref(i)->pllxcr;
+
+					ERROR("PLL%d start failed @ 0x%lx: 0x%x\n",
+					      i, pllxcr, mmio_read_32(pllxcr));
+				}
+			}
+
+			return -ETIMEDOUT;
+		}
+	}
+
+	return 0;
+}
+
 static int stm32mp1_pll_stop(enum stm32mp1_pll_id pll_id)
 {
 	const struct stm32mp1_clk_pll *pll = pll_ref(pll_id);
@@ -1698,6 +1937,8 @@ static void stm32mp1_pll_config_output(enum stm32mp1_pll_id pll_id,
 	value = stm32mp1_pll_compute_pllxcfgr2(pllcfg);
 
 	mmio_write_32(rcc_base + pll->pllxcfgr2, value);
+
+	rcc_shadow_flush();
 }
 
 static int stm32mp1_pll_compute_pllxcfgr1(const struct stm32mp1_clk_pll *pll,
@@ -1758,6 +1999,7 @@ static int stm32mp1_pll_config(enum stm32mp1_pll_id pll_id,
 	mmio_write_32(rcc_base + pll->pllxfracr, value);
 	mmio_setbits_32(rcc_base + pll->pllxfracr, RCC_PLLNFRACR_FRACLE);
 
+	/* Also flushes the RCC shadow */
 	stm32mp1_pll_config_output(pll_id, pllcfg);
 
 	return 0;
@@ -1790,6 +2032,7 @@ static int stm32mp1_set_clksrc(unsigned int clksrc)
 
 	mmio_clrsetbits_32(clksrc_address, RCC_SELR_SRC_MASK,
 			   clksrc & RCC_SELR_SRC_MASK);
+	rcc_shadow_flush();
 
 	timeout = timeout_init_us(CLKSRC_TIMEOUT);
 	while ((mmio_read_32(clksrc_address) & RCC_SELR_SRCRDY) == 0U) {
@@ -1809,6 +2052,7 @@ static int stm32mp1_set_clkdiv(unsigned int clkdiv, uintptr_t address)
 
 	mmio_clrsetbits_32(address, RCC_DIVR_DIV_MASK,
 			   clkdiv & RCC_DIVR_DIV_MASK);
+	rcc_shadow_flush();
 
 	timeout = timeout_init_us(CLKDIV_TIMEOUT);
 	while ((mmio_read_32(address) & RCC_DIVR_DIVRDY) == 0U) {
@@ -2478,6 +2722,37 @@ void stm32mp1_clk_lp_load_opp_pll1_settings(uint8_t *data, size_t size)
 	memcpy(&pll1_settings, data, size);
 }
 
+#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+/*
+ * Trace the time spent in each clock tree bring-up step. The STGEN counter
+ * is rescaled when its source changes, so a count converted with the current
+ * frequency stays monotonic across stm32mp_stgen_config().
+ */
+static uint64_t clk_init_time_us(void)
+{
+	return (read_cntpct_el0() * 1000000ULL) / read_cntfrq_el0();
+}
+
+static void clk_init_step(const char *step, uint64_t *time_us)
+{
+	uint64_t now_us = clk_init_time_us();
+
+	VERBOSE("clk init: %s in %lu us\n", step,
+		(unsigned long)(now_us - *time_us));
+	*time_us = now_us;
+}
+#else
+static uint64_t clk_init_time_us(void)
+{
+	return 0ULL;
+}
+
+static void clk_init_step(const char *step __unused,
+			  uint64_t *time_us __unused)
+{
+}
+#endif
+
 int stm32mp1_clk_init(uint32_t pll1_freq_khz)
 {
 	uintptr_t rcc_base = stm32mp_rcc_base();
@@ -2492,6 +2767,12 @@ int stm32mp1_clk_init(uint32_t pll1_freq_khz)
 	bool pllcsg_set[_PLL_NB];
 	bool pllcfg_valid[_PLL_NB];
 	bool lse_css = false;
+	bool hse_bypass = false;
+	bool hse_digbyp = false;
+	bool hse_css = false;
+	uint32_t hs_osc_rdy;
+	uint32_t pll_wait = 0U;
+	uint64_t time_us = clk_init_time_us();
 	bool pll3_preserve = false;
 	bool pll4_preserve = false;
 	bool pll4_bootrom = false;
@@ -2550,9 +2831,14 @@ int stm32mp1_clk_init(uint32_t pll1_freq_khz)
 	stm32mp1_mco_csg(clksrc[CLKSRC_MCO1], clkdiv[CLKDIV_MCO1]);
 	stm32mp1_mco_csg(clksrc[CLKSRC_MCO2], clkdiv[CLKDIV_MCO2]);
 
+	clk_init_step("DT parsing", &time_us);
+
 	/*
 	 * Switch ON oscillator found in device-tree.
 	 * Note: HSI already ON after BootROM stage.
+	 * LSE, HSE and CSI are started together: HSE and CSI readiness is
+	 * only awaited before the PLL sources are selected, LSE readiness
+	 * before the RTC source is selected.
 	 */
 	if (stm32mp1_osc[_LSI] != 0U) {
 		stm32mp1_lsi_set(true);
@@ -2571,18 +2857,19 @@ int stm32mp1_clk_init(uint32_t pll1_freq_khz)
 	}
 	if (stm32mp1_osc[_HSE] != 0U) {
 		const char *name = stm32mp_osc_node_label[_HSE];
-		bool bypass, digbyp, css;
 
-		bypass = fdt_clk_read_bool(name, "st,bypass");
-		digbyp = fdt_clk_read_bool(name, "st,digbypass");
-		css = fdt_clk_read_bool(name, "st,css");
-		stm32mp1_hse_enable(bypass, digbyp, css);
+		hse_bypass = fdt_clk_read_bool(name, "st,bypass");
+		hse_digbyp = fdt_clk_read_bool(name, "st,digbypass");
+		hse_css = fdt_clk_read_bool(name, "st,css");
+		stm32mp1_hse_enable(hse_bypass, hse_digbyp);
 	}
 	/*
 	 * CSI is mandatory for automatic I/O compensation (SYSCFG_CMPCR)
 	 * => switch on CSI even if node is not present in device tree
 	 */
-	stm32mp1_csi_set(true);
+	stm32mp1_csi_enable();
+
+	clk_init_step("oscillators start", &time_us);
 
 	/* Come back to HSI */
 	ret = stm32mp1_set_clksrc(CLK_MPU_HSI);
@@ -2638,6 +2925,8 @@ int stm32mp1_clk_init(uint32_t pll1_freq_khz)
 		stm32mp_stgen_config(stm32mp_clk_get_rate(STGEN_K));
 	}
 
+	clk_init_step("PLLs stop", &time_us);
+
 	/* Select DIV */
 	/* No ready bit when MPUSRC != CLK_MPU_PLL1P_DIV, MPUDIV is disabled */
 	mmio_write_32(rcc_base + RCC_MPCKDIVR,
@@ -2675,6 +2964,20 @@ int stm32mp1_clk_init(uint32_t pll1_freq_khz)
 	mmio_write_32(rcc_base + RCC_RTCDIVR,
 		      clkdiv[CLKDIV_RTC] & RCC_DIVR_DIV_MASK);
 
+	clk_init_step("dividers", &time_us);
+
+	/* HSE and CSI may be PLL sources: wait both ready */
+	hs_osc_rdy = RCC_OCRDYR_CSIRDY;
+	if (stm32mp1_osc[_HSE] != 0U) {
+		hs_osc_rdy |= RCC_OCRDYR_HSERDY;
+	}
+	stm32mp1_hs_osc_wait(hs_osc_rdy);
+	if (stm32mp1_osc[_HSE] != 0U) {
+		stm32mp1_hse_css(hse_bypass, hse_digbyp, hse_css);
+	}
+
+	clk_init_step("HSE/CSI ready", &time_us);
+
 	/* Configure PLLs source */
 	ret = stm32mp1_set_clksrc(clksrc[CLKSRC_PLL12]);
 	if (ret != 0) {
@@ -2723,22 +3026,28 @@ int stm32mp1_clk_init(uint32_t pll1_freq_khz)
 
 		stm32mp1_pll_start(i);
 	}
-	/* Wait and start PLLs ouptut when ready */
-	for (i = (enum stm32mp1_pll_id)0; i < _PLL_NB; i++) {
-		if (!pllcfg_valid[i]) {
-			continue;
-		}
 
-		ret = stm32mp1_pll_output(i, pllcfg[i][PLLCFG_O]);
-		if (ret != 0) {
-			return ret;
+	for (i = (enum stm32mp1_pll_id)0; i < _PLL_NB; i++) {
+		if (pllcfg_valid[i]) {
+			pll_wait |= BIT(i);
 		}
 	}
-	/* Wait LSE ready before to use it */
-	if (stm32mp1_osc[_LSE] != 0U) {
-		stm32mp1_lse_wait();
+
+	clk_init_step("PLLs start", &time_us);
+
+	/*
+	 * Wait and start PLLs output when ready. MPU and AXI are moved to
+	 * their expected source once PLL1 and PLL2 are locked, while PLL3 and
+	 * PLL4 are still locking.
+	 */
+	ret = stm32mp1_pll_wait_output(pll_wait & (BIT(_PLL1) | BIT(_PLL2)),
+				       pllcfg);
+	if (ret != 0) {
+		return ret;
 	}
 
+	clk_init_step("PLL1/PLL2 lock", &time_us);
+
 	/* Configure with expected clock source */
 	ret = stm32mp1_set_clksrc(clksrc[CLKSRC_MPU]);
 	if (ret != 0) {
@@ -2748,10 +3057,29 @@ int stm32mp1_clk_init(uint32_t pll1_freq_khz)
 	if (ret != 0) {
 		return ret;
 	}
+
+	clk_init_step("MPU/AXI switch", &time_us);
+
+	ret = stm32mp1_pll_wait_output(pll_wait & (BIT(_PLL3) | BIT(_PLL4)),
+				       pllcfg);
+	if (ret != 0) {
+		return ret;
+	}
+
+	clk_init_step("PLL3/PLL4 lock", &time_us);
+
 	ret = stm32mp1_set_clksrc(clksrc[CLKSRC_MCU]);
 	if (ret != 0) {
 		return ret;
 	}
+
+	/* Wait LSE ready before to use it */
+	if (stm32mp1_osc[_LSE] != 0U) {
+		stm32mp1_lse_wait();
+	}
+
+	clk_init_step("LSE ready", &time_us);
+
 	stm32mp1_set_rtcsrc(clksrc[CLKSRC_RTC], lse_css);
 
 	/* Configure PKCK */
@@ -2812,6 +3140,8 @@ int stm32mp1_clk_init(uint32_t pll1_freq_khz)
 
 	stm32mp_stgen_config(stm32mp_clk_get_rate(STGEN_K));
 
+	clk_init_step("kernel clocks", &time_us);
+
 	/* Software Self-Refresh mode (SSR) during DDR initilialization */
 	mmio_clrsetbits_32(rcc_base + RCC_DDRITFCR,
 			   RCC_DDRITFCR_DDRCKMOD_MASK,
@@ -3100,6 +3430,8 @@ static void restore_mux_cfg(void)
 
 		mmio_clrsetbits_32(base + cfg[i].offset, mask, value);
 	}
+
+	rcc_shadow_flush();
 }
 
 /* Structure is used for set/clear registers and for regular registers */
@@ -3156,6 +3488,8 @@ static void restore_sc_cfg(void)
 		mmio_write_32(base + cfg[i].offset + RCC_MP_ENCLRR_OFFSET,
 			      ~cfg[i].value);
 	}
+
+	rcc_shadow_flush_gates();
 }
 
 static void backup_regular_cfg(void)
@@ -3180,6 +3514,8 @@ static void restore_regular_cfg(void)
 	for (i = 0U; i < count; i++) {
 		mmio_write_32(base + cfg[i].offset, cfg[i].value);
 	}
+
+	rcc_shadow_flush();
 }
 
 static void disable_kernel_clocks(void)
@@ -3207,8 +3543,10 @@ static void enable_kernel_clocks(void)
 
 static void clear_rcc_reset_status(void)
 {
-	/* Clear reset status fields */
-	mmio_write_32(stm32mp_rcc_base() + RCC_MP_RSTSCLRR, 0U);
+	uintptr_t rstsclrr = stm32mp_rcc_base() + RCC_MP_RSTSCLRR;
+
+	/* Clear reset status fields, write 1 to clear */
+	mmio_write_32(rstsclrr, mmio_read_32(rstsclrr));
 }
 
 void save_clock_pm_context(void)
@@ -3367,6 +3705,7 @@ int stm32mp1_clock_stopmode_resume(void)
 
 	/* Restore MCU clock src after PLL3 RDY */
 	mmio_write_32(rcc_base + RCC_MSSCKSELR, mssckselr);
+	rcc_shadow_flush();
 
 	/* Restore MCUDIV */
 	res = stm32mp1_set_clkdiv(mcudivr, rcc_base + RCC_MCUDIVR);
@@ -3383,6 +3722,8 @@ int stm32mp1_clock_stopmode_resume(void)
 	mmio_clrsetbits_32(rcc_base + RCC_MP_APB4ENSETR,
 			   RCC_MP_APB4ENSETR_IWDG2APBEN,
 			   mpapb_iwdg2);
+
+	rcc_shadow_flush_gates();
 #endif
 
 	disable_kernel_clocks();
@@ -3399,6 +3740,8 @@ void stm32mp1_clk_mcuss_protect(bool enable)
 	} else {
 		mmio_clrbits_32(rcc_base + RCC_TZCR, RCC_TZCR_MCKPROT);
 	}
+
+	rcc_shadow_flush();
 }
 
 /* Sync secure clock refcount after all drivers probe/inits,  */
@@ -3465,6 +3808,9 @@ int stm32mp1_clk_probe(void)
 
 	stm32mp1_osc_init();
 
+	/* RCC_TZCR and the oscillator rates may have changed */
+	rcc_shadow_flush();
+
 	sync_earlyboot_clocks_state();
 
 	/* Save current CPU operating point value */
@@ -4,18 +4,38 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <libfdt.h>
+
 #include <platform_def.h>
 
 #include <arch_helpers.h>
 #include <common/debug.h>
+#include <drivers/clk.h>
 #include <drivers/delay_timer.h>
 #include <drivers/st/stm32mp1_ddr.h>
 #include <drivers/st/stm32mp1_ddr_helpers.h>
 #include <drivers/st/stm32mp1_ddr_regs.h>
 #include <lib/mmio.h>
+#include <lib/spinlock.h>
 
 #define TIMEOUT_500US	500U
 
+/* DDRPERFM registers */
+#define DDRPERFM_CTL		0x000
+#define DDRPERFM_CFG		0x004
+#define DDRPERFM_CCR		0x00C
+#define DDRPERFM_TCNT		0x020
+#define DDRPERFM_CNT(x)		(0x030 + (8 * (x)))
+
+#define DDRPERFM_CTL_START	BIT(0)
+#define DDRPERFM_CTL_STOP	BIT(1)
+#define DDRPERFM_CFG_EN_ALL	GENMASK(3, 0)
+#define DDRPERFM_CCR_CLR_ALL	(BIT(31) | GENMASK(3, 0))
+
 static enum stm32mp1_ddr_sr_mode saved_ddr_sr_mode;
 
 void ddr_enable_clock(void)
@@ -613,3 +633,337 @@ bool ddr_is_nonsecured_area(uintptr_t address, uint32_t length)
 
 	return false;
 }
+
+#if defined(IMAGE_BL32)
+#define DDR_QOS_SCHED_MASK	U(0x7FFF1F07)
+#define DDR_QOS_SCHED1_MASK	U(0x000000FF)
+#define DDR_QOS_PERF_MASK	U(0xFF00FFFF)
+#define DDR_QOS_PCFGR_MASK	U(0x000173FF)
+#define DDR_QOS_PCFGW_MASK	U(0x000073FF)
+#define DDR_QOS_PCFGQOS0_MASK	U(0x03330F0F)
+#define DDR_QOS_PCFGQOS1_MASK	U(0x07FF07FF)
+
+/* PCFG[W]QOS0 map regions 0 to 2 to a traffic class, 2 bits each */
+#define DDR_QOS_MAP_REGION_SHIFT	16
+#define DDR_QOS_MAP_REGION_NB		3U
+#define DDR_QOS_MAP_REGION_STEP		4
+#define DDR_QOS_MAP_REGION_MASK		U(0x3)
+/* Read: LPR, VPR or HPR. Write: NPW or VPW */
+#define DDR_QOS_RD_CLASS_MAX		U(2)
+#define DDR_QOS_WR_CLASS_MAX		U(1)
+
+#define DDR_QOS_REG(_reg, _mask, _class_max)				\
+	{								\
+		.offset = offsetof(struct stm32mp1_ddrctl, _reg),	\
+		.mask = (_mask),					\
+		.class_max = (_class_max),				\
+	}
+
+/*
+ * QoS registers, in the st,ctl-perf binding order, with their defined fields
+ * and, for the QoS maps, the highest traffic class a region can be mapped to.
+ */
+static const struct {
+	uint16_t offset;
+	uint32_t mask;
+	uint32_t class_max;
+} ddr_qos_reg[] = {
+	DDR_QOS_REG(sched, DDR_QOS_SCHED_MASK, 0U),
+	DDR_QOS_REG(sched1, DDR_QOS_SCHED1_MASK, 0U),
+	DDR_QOS_REG(perfhpr1, DDR_QOS_PERF_MASK, 0U),
+	DDR_QOS_REG(perflpr1, DDR_QOS_PERF_MASK, 0U),
+	DDR_QOS_REG(perfwr1, DDR_QOS_PERF_MASK, 0U),
+	DDR_QOS_REG(pcfgr_0, DDR_QOS_PCFGR_MASK, 0U),
+	DDR_QOS_REG(pcfgw_0, DDR_QOS_PCFGW_MASK, 0U),
+	DDR_QOS_REG(pcfgqos0_0, DDR_QOS_PCFGQOS0_MASK, DDR_QOS_RD_CLASS_MAX),
+	DDR_QOS_REG(pcfgqos1_0, DDR_QOS_PCFGQOS1_MASK, 0U),
+	DDR_QOS_REG(pcfgwqos0_0, DDR_QOS_PCFGQOS0_MASK, DDR_QOS_WR_CLASS_MAX),
+	DDR_QOS_REG(pcfgwqos1_0, DDR_QOS_PCFGQOS1_MASK, 0U),
+#if STM32MP_DDR_DUAL_AXI_PORT
+	DDR_QOS_REG(pcfgr_1, DDR_QOS_PCFGR_MASK, 0U),
+	DDR_QOS_REG(pcfgw_1, DDR_QOS_PCFGW_MASK, 0U),
+	DDR_QOS_REG(pcfgqos0_1, DDR_QOS_PCFGQOS0_MASK, DDR_QOS_RD_CLASS_MAX),
+	DDR_QOS_REG(pcfgqos1_1, DDR_QOS_PCFGQOS1_MASK, 0U),
+	DDR_QOS_REG(pcfgwqos0_1, DDR_QOS_PCFGQOS0_MASK, DDR_QOS_WR_CLASS_MAX),
+	DDR_QOS_REG(pcfgwqos1_1, DDR_QOS_PCFGQOS1_MASK, 0U),
+#endif
+};
+
+#define DDR_QOS_REG_NB		ARRAY_SIZE(ddr_qos_reg)
+
+/* Profile 0 holds the settings BL2 applied */
+static uint32_t ddr_qos_profile[DDR_QOS_PROFILE_MAX][DDR_QOS_REG_NB];
+static unsigned int ddr_qos_profile_nb;
+static unsigned int ddr_qos_current;
+
+#if !STM32MP_SP_MIN_IN_DDR
+static struct spinlock ddr_qos_lock;
+
+static void ddr_ports_enable(bool enable)
+{
+	uintptr_t ddrctrl_base = stm32mp_ddrctrl_base();
+
+	if (enable) {
+		mmio_setbits_32(ddrctrl_base + DDRCTRL_PCTRL_0,
+				DDRCTRL_PCTRL_N_PORT_EN);
+#if STM32MP_DDR_DUAL_AXI_PORT
+		mmio_setbits_32(ddrctrl_base + DDRCTRL_PCTRL_1,
+				DDRCTRL_PCTRL_N_PORT_EN);
+#endif
+	} else {
+		mmio_clrbits_32(ddrctrl_base + DDRCTRL_PCTRL_0,
+				DDRCTRL_PCTRL_N_PORT_EN);
+#if STM32MP_DDR_DUAL_AXI_PORT
+		mmio_clrbits_32(ddrctrl_base + DDRCTRL_PCTRL_1,
+				DDRCTRL_PCTRL_N_PORT_EN);
+#endif
+	}
+}
+#endif
+
+/*
+ * Check a DT profile: no reserved bit is set, no QoS map region is mapped to
+ * a reserved traffic class and SCHED.lpr_num_entries, a static field, is
+ * unchanged.
+ */
+static bool ddr_qos_profile_is_valid(const uint32_t *profile, uint32_t lpr)
+{
+	unsigned int i;
+	unsigned int r;
+
+	if ((profile[0] & DDRCTRL_SCHED_LPR_NUM_ENTRIES_MASK) != lpr) {
+		return false;
+	}
+
+	for (i = 0U; i < DDR_QOS_REG_NB; i++) {
+		if ((profile[i] & ~ddr_qos_reg[i].mask) != 0U) {
+			return false;
+		}
+
+		if (ddr_qos_reg[i].class_max == 0U) {
+			continue;
+		}
+
+		for (r = 0U; r < DDR_QOS_MAP_REGION_NB; r++) {
+			uint32_t class = (profile[i] >>
+					  (DDR_QOS_MAP_REGION_SHIFT +
+					   (r * DDR_QOS_MAP_REGION_STEP))) &
+					 DDR_QOS_MAP_REGION_MASK;
+
+			if (class > ddr_qos_reg[i].class_max) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Read the boot QoS settings as profile 0, then append the valid DT profiles.
+ * The whole property is rejected if its size does not match.
+ */
+int ddr_qos_init(void)
+{
+	uintptr_t ddrctrl_base = stm32mp_ddrctrl_base();
+	uint32_t cells[(DDR_QOS_PROFILE_MAX - 1U) * DDR_QOS_REG_NB];
+	uint32_t lpr = mmio_read_32(ddrctrl_base + DDRCTRL_SCHED) &
+		       DDRCTRL_SCHED_LPR_NUM_ENTRIES_MASK;
+	unsigned int i;
+	int nb;
+
+	for (i = 0U; i < DDR_QOS_REG_NB; i++) {
+		ddr_qos_profile[0][i] = mmio_read_32(ddrctrl_base +
+						     ddr_qos_reg[i].offset);
+	}
+
+	ddr_qos_profile_nb = 1U;
+	ddr_qos_current = 0U;
+
+	nb = dt_get_ddr_qos_profiles(cells, ARRAY_SIZE(cells));
+	if (nb < 0) {
+		return (nb == -FDT_ERR_NOTFOUND) ? 0 : -EINVAL;
+	}
+
+	if (((unsigned int)nb % DDR_QOS_REG_NB) != 0U) {
+		WARN("DDR: invalid QoS profiles size\n");
+		return -EINVAL;
+	}
+
+	for (i = 0U; i < ((unsigned int)nb / DDR_QOS_REG_NB); i++) {
+		const uint32_t *profile = &cells[i * DDR_QOS_REG_NB];
+
+		if (!ddr_qos_profile_is_valid(profile, lpr)) {
+			WARN("DDR: invalid QoS profile %u\n", i + 1U);
+			continue;
+		}
+
+		memcpy(ddr_qos_profile[ddr_qos_profile_nb], profile,
+		       sizeof(ddr_qos_profile[0]));
+		ddr_qos_profile_nb++;
+	}
+
+	VERBOSE("DDR: %u QoS profiles\n", ddr_qos_profile_nb);
+
+	return 0;
+}
+
+unsigned int ddr_qos_get_profile_nb(void)
+{
+	return ddr_qos_profile_nb;
+}
+
+unsigned int ddr_qos_get_profile(void)
+{
+	return ddr_qos_current;
+}
+
+/*
+ * Apply a QoS profile. The registers are quasi-dynamic: the AXI ports are
+ * blocked until they are idle and the controller queues are drained, then the
+ * registers are written between a SW_DONE handshake and its acknowledge.
+ * Masters accessing the DDR are stalled meanwhile, hence this cannot run from
+ * DDR.
+ */
+int ddr_qos_set_profile(unsigned int id)
+{
+#if STM32MP_SP_MIN_IN_DDR
+	(void)id;
+
+	return -ENOTSUP;
+#else
+	uintptr_t ddrctrl_base = stm32mp_ddrctrl_base();
+	uint64_t timeout;
+	uint32_t dbgcam;
+	unsigned int i;
+	int ret = 0;
+
+	if (id >= ddr_qos_profile_nb) {
+		return -EINVAL;
+	}
+
+	spin_lock(&ddr_qos_lock);
+
+	if (id == ddr_qos_current) {
+		goto out;
+	}
+
+	ddr_ports_enable(false);
+
+	timeout = timeout_init_us(TIMEOUT_500US);
+	while (mmio_read_32(ddrctrl_base + DDRCTRL_PSTAT) != 0U) {
+		if (timeout_elapsed(timeout)) {
+			ret = -ETIMEDOUT;
+			goto ports;
+		}
+	}
+
+	/* Queues are empty when WR_Q_EMPTY is set and the depths are 0 */
+	timeout = timeout_init_us(TIMEOUT_500US);
+	do {
+		if (timeout_elapsed(timeout)) {
+			ret = -ETIMEDOUT;
+			goto ports;
+		}
+
+		dbgcam = mmio_read_32(ddrctrl_base + DDRCTRL_DBGCAM);
+	} while ((dbgcam & (DDRCTRL_DBGCAM_DATA_PIPELINE_EMPTY |
+			    DDRCTRL_DBGCAM_DBG_Q_DEPTH)) !=
+		 (DDRCTRL_DBGCAM_DATA_PIPELINE_EMPTY |
+		  DDRCTRL_DBGCAM_DBG_WR_Q_EMPTY));
+
+	do_sw_handshake();
+
+	for (i = 0U; i < DDR_QOS_REG_NB; i++) {
+		mmio_write_32(ddrctrl_base + ddr_qos_reg[i].offset,
+			      ddr_qos_profile[id][i]);
+	}
+
+	do_sw_ack();
+
+	ddr_qos_current = id;
+
+ports:
+	ddr_ports_enable(true);
+out:
+	spin_unlock(&ddr_qos_lock);
+
+	return ret;
+#endif
+}
+
+/*
+ * DDRPERFM counters: read, write, activate and idle cycles, then the time
+ * counter as DDR_PERF_CNT_TIME. Counting runs from ddr_perf_start() to
+ * ddr_perf_stop(), the counters are readable meanwhile and after. DDRPERFM is
+ * only clocked while counting: the counters are saved when it stops.
+ */
+static uint32_t ddr_perf_saved[DDR_PERF_CNT_TIME + 1U];
+static bool ddr_perf_running;
+static struct spinlock ddr_perf_lock;
+
+static uint32_t ddr_perf_read_counter(unsigned int counter)
+{
+	if (counter == DDR_PERF_CNT_TIME) {
+		return mmio_read_32(DDRPERFM_BASE + DDRPERFM_TCNT);
+	}
+
+	return mmio_read_32(DDRPERFM_BASE + DDRPERFM_CNT(counter));
+}
+
+void ddr_perf_start(void)
+{
+	spin_lock(&ddr_perf_lock);
+
+	if (!ddr_perf_running) {
+		(void)clk_enable(DDRPERFM);
+		ddr_perf_running = true;
+	}
+
+	mmio_write_32(DDRPERFM_BASE + DDRPERFM_CTL, DDRPERFM_CTL_STOP);
+	mmio_write_32(DDRPERFM_BASE + DDRPERFM_CCR, DDRPERFM_CCR_CLR_ALL);
+	mmio_write_32(DDRPERFM_BASE + DDRPERFM_CFG, DDRPERFM_CFG_EN_ALL);
+	mmio_write_32(DDRPERFM_BASE + DDRPERFM_CTL, DDRPERFM_CTL_START);
+
+	spin_unlock(&ddr_perf_lock);
+}
+
+void ddr_perf_stop(void)
+{
+	unsigned int i;
+
+	spin_lock(&ddr_perf_lock);
+
+	if (ddr_perf_running) {
+		mmio_write_32(DDRPERFM_BASE + DDRPERFM_CTL, DDRPERFM_CTL_STOP);
+
+		for (i = 0U; i <= DDR_PERF_CNT_TIME; i++) {
+			ddr_perf_saved[i] = ddr_perf_read_counter(i);
+		}
+
+		clk_disable(DDRPERFM);
+		ddr_perf_running = false;
+	}
+
+	spin_unlock(&ddr_perf_lock);
+}
+
+int ddr_perf_read(unsigned int counter, uint32_t *value)
+{
+	if (counter > DDR_PERF_CNT_TIME) {
+		return -EINVAL;
+	}
+
+	spin_lock(&ddr_perf_lock);
+
+	if (ddr_perf_running) {
+		*value = ddr_perf_read_counter(counter);
+	} else {
+		*value = ddr_perf_saved[counter];
+	}
+
+	spin_unlock(&ddr_perf_lock);
+
+	return 0;
+}
+#endif /* IMAGE_BL32 */
@@ -306,6 +306,19 @@ static int stm32mp1_ddr_setup(void)
 
 		/* Restore area overwritten by training */
 		stm32_restore_ddr_training_area();
+#if STM32MP_WARM_BOOT
+	} else if (stm32mp1_is_warm_reset()) {
+		/*
+		 * The bus and size tests passed at cold boot. Their patterns
+		 * would corrupt the images that BL2 may use in place.
+		 */
+		uret = ddr_test_rw_access();
+		if (uret != 0U) {
+			ERROR("DDR rw test: Can't access memory @ 0x%x\n",
+			      uret);
+			panic();
+		}
+#endif
 	} else {
 		uret = ddr_test_data_bus();
 		if (uret != 0U) {
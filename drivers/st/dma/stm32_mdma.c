@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2020, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <drivers/clk.h>
+#include <drivers/delay_timer.h>
+#include <drivers/dma.h>
+#include <drivers/st/stm32_mdma.h>
+#include <lib/mmio.h>
+#include <lib/spinlock.h>
+#include <lib/utils_def.h>
+
+/* Channel registers */
+#define MDMA_CISR(x)			(0x40U + (0x40U * (x)))
+#define MDMA_CIFCR(x)			(0x44U + (0x40U * (x)))
+#define MDMA_CESR(x)			(0x48U + (0x40U * (x)))
+#define MDMA_CCR(x)			(0x4CU + (0x40U * (x)))
+#define MDMA_CTCR(x)			(0x50U + (0x40U * (x)))
+#define MDMA_CBNDTR(x)			(0x54U + (0x40U * (x)))
+#define MDMA_CSAR(x)			(0x58U + (0x40U * (x)))
+#define MDMA_CDAR(x)			(0x5CU + (0x40U * (x)))
+#define MDMA_CBRUR(x)			(0x60U + (0x40U * (x)))
+#define MDMA_CLAR(x)			(0x64U + (0x40U * (x)))
+#define MDMA_CTBR(x)			(0x68U + (0x40U * (x)))
+#define MDMA_CMAR(x)			(0x70U + (0x40U * (x)))
+#define MDMA_CMDR(x)			(0x74U + (0x40U * (x)))
+
+/* Channel interrupt status and flag clear registers */
+#define MDMA_CISR_TEIF			BIT(0)
+#define MDMA_CISR_CTCIF			BIT(1)
+#define MDMA_CIFCR_ALL			GENMASK_32(4, 0)
+
+/* Channel control register */
+#define MDMA_CCR_EN			BIT(0)
+#define MDMA_CCR_SM			BIT(8)
+#define MDMA_CCR_SWRQ			BIT(16)
+
+/* Channel transfer configuration register */
+#define MDMA_CTCR_SINC_SHIFT		0
+#define MDMA_CTCR_DINC_SHIFT		2
+#define MDMA_CTCR_SSIZE_SHIFT		4
+#define MDMA_CTCR_DSIZE_SHIFT		6
+#define MDMA_CTCR_SINCOS_SHIFT		8
+#define MDMA_CTCR_DINCOS_SHIFT		10
+#define MDMA_CTCR_SBURST_SHIFT		12
+#define MDMA_CTCR_DBURST_SHIFT		15
+#define MDMA_CTCR_TLEN_SHIFT		18
+#define MDMA_CTCR_TRGM_LIST		(U(3) << 28)
+#define MDMA_CTCR_SWRM			BIT(30)
+#define MDMA_CTCR_BWM			BIT(31)
+#define MDMA_CTCR_INC			U(2)
+
+/* Channel block number of data register */
+#define MDMA_CBNDTR_BRC_SHIFT		20
+
+#define MDMA_CHAN_NB			32U
+#define MDMA_SLOT_NB			4U
+
+#define MDMA_BLOCK_LEN			U(0x10000)
+#define MDMA_BLOCK_REPEAT_MAX		U(0x1000)
+#define MDMA_MAX_LEN			(MDMA_BLOCK_LEN * MDMA_BLOCK_REPEAT_MAX)
+#define MDMA_BUF_LEN			U(128)
+#define MDMA_BURST_MAX_SHIFT		4U
+
+/* Below this, the transfer set-up and cache maintenance cost more */
+#define MDMA_MIN_LEN			U(2048)
+
+/* Allow for 16 bytes per microsecond, far below the bus throughput */
+#define MDMA_TIMEOUT_US(len)		(U(1000) + ((len) / 16U))
+#define MDMA_ABORT_TIMEOUT_US		U(1000)
+
+/* FMC NOR and QUADSPI memory-mapped areas */
+#define MDMA_EXT_MEM_BASE		U(0x60000000)
+#define MDMA_EXT_MEM_END		U(0x80000000)
+
+/* Linked list node, loaded by the channel in CTCR to CMDR */
+struct mdma_node {
+	uint32_t ctcr;
+	uint32_t cbndtr;
+	uint32_t csar;
+	uint32_t cdar;
+	uint32_t cbrur;
+	uint32_t clar;
+	uint32_t ctbr;
+	uint32_t reserved;
+	uint32_t cmar;
+	uint32_t cmdr;
+};
+
+/*
+ * The node and pattern are read by the MDMA and must not share a cache line
+ * with another slot.
+ */
+struct mdma_slot {
+	struct mdma_node node;
+	uint64_t pattern;
+	size_t len;
+	unsigned int chan;
+	bool busy;
+} __aligned(CACHE_WRITEBACK_GRANULE);
+
+static struct mdma_slot slots[MDMA_SLOT_NB];
+static unsigned int slot_nb;
+static struct spinlock slot_lock;
+
+static void mdma_lock(void)
+{
+	if (stm32mp_lock_available()) {
+		spin_lock(&slot_lock);
+	}
+}
+
+static void mdma_unlock(void)
+{
+	if (stm32mp_lock_available()) {
+		spin_unlock(&slot_lock);
+	}
+}
+
+static int mdma_get_slot(void)
+{
+	unsigned int i;
+	int id = -EBUSY;
+
+	mdma_lock();
+
+	for (i = 0U; i < slot_nb; i++) {
+		if (!slots[i].busy) {
+			slots[i].busy = true;
+			id = (int)i;
+			break;
+		}
+	}
+
+	mdma_unlock();
+
+	return id;
+}
+
+static void mdma_put_slot(struct mdma_slot *slot)
+{
+	mdma_lock();
+	slot->busy = false;
+	mdma_unlock();
+}
+
+/* Addresses go straight to the bus: TF-A maps memory flat */
+static bool mdma_range_is_valid(uintptr_t addr, size_t len)
+{
+	uintptr_t end = addr + len - 1U;
+
+	if (end < addr) {
+		return false;
+	}
+
+	if ((addr >= STM32MP_SYSRAM_BASE) &&
+	    (end < (STM32MP_SYSRAM_BASE + STM32MP_SYSRAM_SIZE))) {
+		return true;
+	}
+
+	if ((addr >= MDMA_EXT_MEM_BASE) && (end < MDMA_EXT_MEM_END)) {
+		return true;
+	}
+
+	return addr >= STM32MP_DDR_BASE;
+}
+
+/* Widest data size, as a shift of bytes, both ends and length align on */
+static unsigned int mdma_size_shift(uintptr_t dst, uintptr_t src, size_t len)
+{
+	uintptr_t align = dst | src | len;
+	unsigned int shift = 3U;
+
+	while ((align & (BIT(shift) - 1U)) != 0U) {
+		shift--;
+	}
+
+	return shift;
+}
+
+/*
+ * Describe len bytes as one block, or as repeated blocks of MDMA_BLOCK_LEN
+ * bytes when len is a multiple of it. A fill reads the pattern at src.
+ */
+static void mdma_set_node(struct mdma_node *node, uintptr_t dst,
+			  uintptr_t src, size_t len, bool fill,
+			  uintptr_t next)
+{
+	size_t block = MIN(len, (size_t)MDMA_BLOCK_LEN);
+	size_t repeat = len / block;
+	unsigned int size = mdma_size_shift(dst, src, block);
+	size_t tlen = MIN(block, (size_t)MDMA_BUF_LEN);
+	unsigned int burst = 0U;
+
+	assert((len % block) == 0U);
+
+	while ((burst < MDMA_BURST_MAX_SHIFT) &&
+	       (BIT(burst + 1U + size) <= tlen)) {
+		burst++;
+	}
+
+	node->ctcr = MDMA_CTCR_BWM | MDMA_CTCR_SWRM | MDMA_CTCR_TRGM_LIST |
+		     ((uint32_t)(tlen - 1U) << MDMA_CTCR_TLEN_SHIFT) |
+		     (burst << MDMA_CTCR_DBURST_SHIFT) |
+		     (size << MDMA_CTCR_DINCOS_SHIFT) |
+		     (size << MDMA_CTCR_DSIZE_SHIFT) |
+		     (size << MDMA_CTCR_SSIZE_SHIFT) |
+		     (MDMA_CTCR_INC << MDMA_CTCR_DINC_SHIFT);
+
+	if (!fill) {
+		node->ctcr |= (burst << MDMA_CTCR_SBURST_SHIFT) |
+			      (size << MDMA_CTCR_SINCOS_SHIFT) |
+			      (MDMA_CTCR_INC << MDMA_CTCR_SINC_SHIFT);
+	}
+
+	node->cbndtr = ((uint32_t)(repeat - 1U) << MDMA_CBNDTR_BRC_SHIFT) |
+		       (uint32_t)block;
+	node->csar = (uint32_t)src;
+	node->cdar = (uint32_t)dst;
+	node->cbrur = 0U;
+	node->clar = (uint32_t)next;
+	node->ctbr = 0U;
+	node->reserved = 0U;
+	node->cmar = 0U;
+	node->cmdr = 0U;
+}
+
+/*
+ * Run a transfer as a whole number of MDMA_BLOCK_LEN blocks followed by the
+ * remainder, linked from the first node.
+ */
+static int mdma_start(uintptr_t dst, uintptr_t src, size_t len,
+		      uint8_t value, bool fill)
+{
+	uintptr_t base = MDMA_BASE;
+	struct mdma_node first;
+	struct mdma_slot *slot;
+	size_t bulk = len - (len % MDMA_BLOCK_LEN);
+	size_t rem = len - bulk;
+	unsigned int chan;
+	int id;
+
+	if ((len == 0U) || (len > MDMA_MAX_LEN) ||
+	    !mdma_range_is_valid(dst, len) ||
+	    (!fill && !mdma_range_is_valid(src, len))) {
+		return -EINVAL;
+	}
+
+	id = mdma_get_slot();
+	if (id < 0) {
+		return id;
+	}
+
+	slot = &slots[id];
+	chan = slot->chan;
+
+	if (fill) {
+		slot->pattern = (uint64_t)value * ULL(0x0101010101010101);
+		src = (uintptr_t)&slot->pattern;
+	}
+
+	if ((bulk != 0U) && (rem != 0U)) {
+		mdma_set_node(&slot->node, dst + bulk, fill ? src : src + bulk,
+			      rem, fill, 0U);
+		mdma_set_node(&first, dst, src, bulk, fill,
+			      (uintptr_t)&slot->node);
+	} else {
+		mdma_set_node(&first, dst, src, len, fill, 0U);
+	}
+
+	flush_dcache_range((uintptr_t)slot, sizeof(*slot));
+
+	slot->len = len;
+
+	clk_enable(MDMA);
+
+	mmio_write_32(base + MDMA_CIFCR(chan), MDMA_CIFCR_ALL);
+	mmio_write_32(base + MDMA_CTCR(chan), first.ctcr);
+	mmio_write_32(base + MDMA_CBNDTR(chan), first.cbndtr);
+	mmio_write_32(base + MDMA_CSAR(chan), first.csar);
+	mmio_write_32(base + MDMA_CDAR(chan), first.cdar);
+	mmio_write_32(base + MDMA_CBRUR(chan), first.cbrur);
+	mmio_write_32(base + MDMA_CLAR(chan), first.clar);
+	mmio_write_32(base + MDMA_CTBR(chan), first.ctbr);
+	mmio_write_32(base + MDMA_CMAR(chan), first.cmar);
+	mmio_write_32(base + MDMA_CMDR(chan), first.cmdr);
+
+	/* Secure channel: the data may be in secure memory */
+	mmio_write_32(base + MDMA_CCR(chan), MDMA_CCR_SM);
+	mmio_setbits_32(base + MDMA_CCR(chan), MDMA_CCR_EN);
+	mmio_setbits_32(base + MDMA_CCR(chan), MDMA_CCR_SWRQ);
+
+	return id;
+}
+
+static int stm32_mdma_copy(uintptr_t dst, uintptr_t src, size_t len)
+{
+	return mdma_start(dst, src, len, 0U, false);
+}
+
+static int stm32_mdma_fill(uintptr_t dst, uint8_t value, size_t len)
+{
+	return mdma_start(dst, 0U, len, value, true);
+}
+
+static int stm32_mdma_wait(int id)
+{
+	uintptr_t base = MDMA_BASE;
+	struct mdma_slot *slot;
+	unsigned int chan;
+	uint64_t timeout;
+	uint32_t isr;
+	int ret = 0;
+
+	assert((id >= 0) && ((unsigned int)id < slot_nb));
+
+	slot = &slots[id];
+	chan = slot->chan;
+
+	timeout = timeout_init_us(MDMA_TIMEOUT_US(slot->len));
+	do {
+		isr = mmio_read_32(base + MDMA_CISR(chan));
+		if ((isr & (MDMA_CISR_TEIF | MDMA_CISR_CTCIF)) != 0U) {
+			break;
+		}
+
+		if (timeout_elapsed(timeout)) {
+			ret = -ETIMEDOUT;
+			break;
+		}
+	} while (true);
+
+	if ((isr & MDMA_CISR_TEIF) != 0U) {
+		ERROR("MDMA: channel %u error 0x%x\n", chan,
+		      mmio_read_32(base + MDMA_CESR(chan)));
+		ret = -EIO;
+	}
+
+	/* Also aborts a transfer that timed out */
+	mmio_clrbits_32(base + MDMA_CCR(chan), MDMA_CCR_EN);
+
+	/* An aborted channel is only disabled once its current burst is done */
+	timeout = timeout_init_us(MDMA_ABORT_TIMEOUT_US);
+	while ((mmio_read_32(base + MDMA_CCR(chan)) & MDMA_CCR_EN) != 0U) {
+		if (timeout_elapsed(timeout)) {
+			ERROR("MDMA: channel %u stuck\n", chan);
+			clk_disable(MDMA);
+			/* The slot is not released: its channel is not reused */
+			return -ETIMEDOUT;
+		}
+	}
+
+	mmio_write_32(base + MDMA_CIFCR(chan), MDMA_CIFCR_ALL);
+
+	/* Leave the channel to the non-secure world */
+	mmio_write_32(base + MDMA_CCR(chan), 0U);
+
+	clk_disable(MDMA);
+
+	mdma_put_slot(slot);
+
+	return ret;
+}
+
+static const dma_ops_t stm32_mdma_ops = {
+	.copy = stm32_mdma_copy,
+	.fill = stm32_mdma_fill,
+	.wait = stm32_mdma_wait,
+	.min_len = MDMA_MIN_LEN,
+};
+
+/*
+ * Register the MDMA as DMA engine, using the idle channels set in the
+ * channels mask, up to MDMA_SLOT_NB.
+ */
+int stm32_mdma_init(uint32_t channels)
+{
+	uintptr_t base = MDMA_BASE;
+	unsigned int chan;
+
+	clk_enable(MDMA);
+
+	for (chan = 0U; (chan < MDMA_CHAN_NB) && (slot_nb < MDMA_SLOT_NB);
+	     chan++) {
+		if ((channels & BIT(chan)) == 0U) {
+			continue;
+		}
+
+		if ((mmio_read_32(base + MDMA_CCR(chan)) & MDMA_CCR_EN) != 0U) {
+			WARN("MDMA: channel %u busy\n", chan);
+			continue;
+		}
+
+		slots[slot_nb].chan = chan;
+		slot_nb++;
+	}
+
+	clk_disable(MDMA);
+
+	if (slot_nb == 0U) {
+		return -ENODEV;
+	}
+
+	dma_register(&stm32_mdma_ops);
+
+	return 0;
+}
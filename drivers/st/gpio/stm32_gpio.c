@@ -18,6 +18,7 @@
 #include <drivers/st/stm32_gpio.h>
 #include <drivers/st/stm32mp_clkfunc.h>
 #include <lib/mmio.h>
+#include <lib/utils.h>
 #include <lib/utils_def.h>
 
 #define DT_GPIO_BANK_SHIFT	12
@@ -26,6 +27,26 @@
 #define DT_GPIO_PIN_MASK	GENMASK(11, 8)
 #define DT_GPIO_MODE_MASK	GENMASK(7, 0)
 
+/* Banks whose settings are accumulated before being applied */
+#define GPIO_CFG_BANK_NB	4U
+
+/* Register images of the pins set in a bank */
+struct gpio_bank_cfg {
+	uint32_t bank;
+	uint32_t pins;
+	uint32_t secure;
+	uint32_t mode;
+	uint32_t otype;
+	uint32_t ospeed;
+	uint32_t pupd;
+	uint32_t afr[2];
+};
+
+struct gpio_cfg {
+	struct gpio_bank_cfg bank[GPIO_CFG_BANK_NB];
+	unsigned int nb;
+};
+
 /*******************************************************************************
  * This function gets GPIO bank node in DT.
  * Returns node offset if status is okay in DT, else return 0
@@ -57,12 +78,165 @@ static int ckeck_gpio_bank(void *fdt, uint32_t bank, int pinctrl_node)
 	return 0;
 }
 
+/* Spread a pin mask to the 2-bit per pin fields of MODE, OSPEED and PUPD */
+static uint32_t gpio_pins_to_mask2(uint32_t pins)
+{
+	uint32_t mask = 0U;
+	uint32_t pin;
+
+	for (pin = 0U; pin <= GPIO_PIN_MAX; pin++) {
+		if ((pins & BIT(pin)) != 0U) {
+			mask |= U(0x3) << (pin << 1);
+		}
+	}
+
+	return mask;
+}
+
+/* Spread a pin mask to the 4-bit per pin fields of AFRL or AFRH */
+static uint32_t gpio_pins_to_mask4(uint32_t pins)
+{
+	uint32_t mask = 0U;
+	uint32_t pin;
+
+	for (pin = 0U; pin < GPIO_ALT_LOWER_LIMIT; pin++) {
+		if ((pins & BIT(pin)) != 0U) {
+			mask |= GPIO_ALTERNATE_MASK << (pin << 2);
+		}
+	}
+
+	return mask;
+}
+
+/*
+ * Apply the settings of a bank: one access per register under a single
+ * clock enable, then register the pins secure state.
+ */
+static void gpio_apply_bank_cfg(const struct gpio_bank_cfg *cfg)
+{
+	uintptr_t base = stm32_get_gpio_bank_base(cfg->bank);
+	unsigned long clock = stm32_get_gpio_bank_clock(cfg->bank);
+	uint32_t mask2 = gpio_pins_to_mask2(cfg->pins);
+	uint32_t afrl_mask = gpio_pins_to_mask4(cfg->pins & GENMASK(7, 0));
+	uint32_t afrh_mask = gpio_pins_to_mask4(cfg->pins >>
+						GPIO_ALT_LOWER_LIMIT);
+	uint32_t pin;
+
+	clk_enable(clock);
+
+	mmio_clrsetbits_32(base + GPIO_MODE_OFFSET, mask2, cfg->mode);
+	mmio_clrsetbits_32(base + GPIO_TYPE_OFFSET, cfg->pins, cfg->otype);
+	mmio_clrsetbits_32(base + GPIO_SPEED_OFFSET, mask2, cfg->ospeed);
+	mmio_clrsetbits_32(base + GPIO_PUPD_OFFSET, mask2, cfg->pupd);
+	if (afrl_mask != 0U) {
+		mmio_clrsetbits_32(base + GPIO_AFRL_OFFSET, afrl_mask,
+				   cfg->afr[0]);
+	}
+	if (afrh_mask != 0U) {
+		mmio_clrsetbits_32(base + GPIO_AFRH_OFFSET, afrh_mask,
+				   cfg->afr[1]);
+	}
+	mmio_clrsetbits_32(base + GPIO_SECR_OFFSET, cfg->pins, cfg->secure);
+
+	VERBOSE("GPIO %u mode set to 0x%x\n", cfg->bank,
+		mmio_read_32(base + GPIO_MODE_OFFSET));
+	VERBOSE("GPIO %u speed set to 0x%x\n", cfg->bank,
+		mmio_read_32(base + GPIO_SPEED_OFFSET));
+	VERBOSE("GPIO %u mode pull to 0x%x\n", cfg->bank,
+		mmio_read_32(base + GPIO_PUPD_OFFSET));
+	VERBOSE("GPIO %u mode alternate low to 0x%x\n", cfg->bank,
+		mmio_read_32(base + GPIO_AFRL_OFFSET));
+	VERBOSE("GPIO %u mode alternate high to 0x%x\n", cfg->bank,
+		mmio_read_32(base + GPIO_AFRH_OFFSET));
+
+	clk_disable(clock);
+
+	for (pin = 0U; pin <= GPIO_PIN_MAX; pin++) {
+		if ((cfg->pins & BIT(pin)) == 0U) {
+			continue;
+		}
+
+		if ((cfg->secure & BIT(pin)) != 0U) {
+			stm32mp_register_secure_gpio(cfg->bank, pin);
+		} else {
+			stm32mp_register_non_secure_gpio(cfg->bank, pin);
+		}
+	}
+}
+
+static void gpio_apply_cfg(struct gpio_cfg *cfg)
+{
+	unsigned int i;
+
+	for (i = 0U; i < cfg->nb; i++) {
+		gpio_apply_bank_cfg(&cfg->bank[i]);
+	}
+
+	cfg->nb = 0U;
+}
+
+/*
+ * Add a pin setting to the bank images. When a new bank does not fit, the
+ * pending settings are applied first.
+ */
+static void gpio_add_pin_cfg(struct gpio_cfg *cfg, uint32_t bank, uint32_t pin,
+			     uint32_t mode, uint32_t speed, uint32_t pull,
+			     uint32_t alternate, uint8_t status)
+{
+	struct gpio_bank_cfg *bank_cfg = NULL;
+	uint32_t afr_shift = (pin % GPIO_ALT_LOWER_LIMIT) << 2;
+	uint32_t mask2 = U(0x3) << (pin << 1);
+	unsigned int i;
+
+	assert(pin <= GPIO_PIN_MAX);
+
+	for (i = 0U; i < cfg->nb; i++) {
+		if (cfg->bank[i].bank == bank) {
+			bank_cfg = &cfg->bank[i];
+			break;
+		}
+	}
+
+	if (bank_cfg == NULL) {
+		if (cfg->nb == GPIO_CFG_BANK_NB) {
+			gpio_apply_cfg(cfg);
+		}
+
+		bank_cfg = &cfg->bank[cfg->nb];
+		zeromem(bank_cfg, sizeof(*bank_cfg));
+		bank_cfg->bank = bank;
+		cfg->nb++;
+	}
+
+	/* A pin set twice keeps its last setting */
+	bank_cfg->pins |= BIT(pin);
+	bank_cfg->mode &= ~mask2;
+	bank_cfg->mode |= ((mode & ~GPIO_OPEN_DRAIN) << (pin << 1)) & mask2;
+	bank_cfg->otype &= ~BIT(pin);
+	if ((mode & GPIO_OPEN_DRAIN) != 0U) {
+		bank_cfg->otype |= BIT(pin);
+	}
+	bank_cfg->ospeed &= ~mask2;
+	bank_cfg->ospeed |= (speed << (pin << 1)) & mask2;
+	bank_cfg->pupd &= ~mask2;
+	bank_cfg->pupd |= (pull << (pin << 1)) & mask2;
+	bank_cfg->afr[pin / GPIO_ALT_LOWER_LIMIT] &=
+		~(GPIO_ALTERNATE_MASK << afr_shift);
+	bank_cfg->afr[pin / GPIO_ALT_LOWER_LIMIT] |=
+		(alternate & GPIO_ALTERNATE_MASK) << afr_shift;
+	bank_cfg->secure &= ~BIT(pin);
+	if (status == DT_SECURE) {
+		bank_cfg->secure |= BIT(pin);
+	}
+}
+
 /*******************************************************************************
- * This function gets the pin settings from DT information.
- * When analyze and parsing is done, set the GPIO registers.
+ * This function gets the pin settings from DT information and adds them to
+ * the bank register images in cfg.
  * Returns 0 on success and a negative FDT error code on failure.
  ******************************************************************************/
-static int dt_set_gpio_config(void *fdt, int node, uint8_t status)
+static int dt_set_gpio_config(void *fdt, int node, uint8_t status,
+			      struct gpio_cfg *cfg)
 {
 	const fdt32_t *cuint, *slewrate;
 	int len;
@@ -146,7 +320,8 @@ static int dt_set_gpio_config(void *fdt, int node, uint8_t status)
 		/* Platform knows the clock: assert it is okay */
 		assert((unsigned long)clk == stm32_get_gpio_bank_clock(bank));
 
-		set_gpio(bank, pin, mode, speed, pull, alternate, status);
+		gpio_add_pin_cfg(cfg, bank, pin, mode, speed, pull, alternate,
+				 status);
 	}
 
 	return 0;
@@ -154,16 +329,18 @@ static int dt_set_gpio_config(void *fdt, int node, uint8_t status)
 
 /*******************************************************************************
  * This function gets the pin settings from DT information.
- * When analyze and parsing is done, set the GPIO registers.
+ * When analyze and parsing is done, set the GPIO registers, bank by bank.
  * Returns 0 on success and a negative FDT/ERRNO error code on failure.
  ******************************************************************************/
 int dt_set_pinctrl_config(int node)
 {
 	const fdt32_t *cuint;
 	int lenp = 0;
+	int ret = 0;
 	uint32_t i;
 	uint8_t status;
 	void *fdt;
+	struct gpio_cfg cfg = { .nb = 0U };
 
 	if (fdt_get_address(&fdt) == 0) {
 		return -FDT_ERR_NOTFOUND;
@@ -179,108 +356,61 @@ int dt_set_pinctrl_config(int node)
 		return -FDT_ERR_NOTFOUND;
 	}
 
-	for (i = 0; i < ((uint32_t)lenp / 4U); i++) {
+	for (i = 0; (i < ((uint32_t)lenp / 4U)) && (ret == 0); i++) {
 		int p_node, p_subnode;
 
 		p_node = fdt_node_offset_by_phandle(fdt, fdt32_to_cpu(*cuint));
 		if (p_node < 0) {
-			return -FDT_ERR_NOTFOUND;
+			ret = -FDT_ERR_NOTFOUND;
+			break;
 		}
 
 		fdt_for_each_subnode(p_subnode, fdt, p_node) {
-			int ret = dt_set_gpio_config(fdt, p_subnode, status);
-
+			ret = dt_set_gpio_config(fdt, p_subnode, status, &cfg);
 			if (ret < 0) {
-				return ret;
+				break;
 			}
 		}
 
 		cuint++;
 	}
 
-	return 0;
+	/* Pins parsed before an error are still set */
+	gpio_apply_cfg(&cfg);
+
+	return ret;
 }
 
 void set_gpio(uint32_t bank, uint32_t pin, uint32_t mode, uint32_t speed,
 	      uint32_t pull, uint32_t alternate, uint8_t status)
+{
+	struct gpio_cfg cfg = { .nb = 0U };
+
+	gpio_add_pin_cfg(&cfg, bank, pin, mode, speed, pull, alternate, status);
+	gpio_apply_cfg(&cfg);
+}
+
+/*
+ * Set the secure state of the pins of a bank: pins set in secure are
+ * secured, other pins in pins are made non-secure.
+ */
+void set_gpio_bank_secure_cfg(uint32_t bank, uint32_t pins, uint32_t secure)
 {
 	uintptr_t base = stm32_get_gpio_bank_base(bank);
 	unsigned long clock = stm32_get_gpio_bank_clock(bank);
 
-	assert(pin <= GPIO_PIN_MAX);
+	assert((pins & ~GENMASK(GPIO_PIN_MAX, 0)) == 0U);
 
 	clk_enable(clock);
 
-	mmio_clrbits_32(base + GPIO_MODE_OFFSET,
-			((uint32_t)GPIO_MODE_MASK << (pin << 1)));
-	mmio_setbits_32(base + GPIO_MODE_OFFSET,
-			(mode & ~GPIO_OPEN_DRAIN) << (pin << 1));
-
-	if ((mode & GPIO_OPEN_DRAIN) != 0U) {
-		mmio_setbits_32(base + GPIO_TYPE_OFFSET, BIT(pin));
-	} else {
-		mmio_clrbits_32(base + GPIO_TYPE_OFFSET, BIT(pin));
-	}
-
-	mmio_clrbits_32(base + GPIO_SPEED_OFFSET,
-			((uint32_t)GPIO_SPEED_MASK << (pin << 1)));
-	mmio_setbits_32(base + GPIO_SPEED_OFFSET, speed << (pin << 1));
-
-	mmio_clrbits_32(base + GPIO_PUPD_OFFSET,
-			((uint32_t)GPIO_PULL_MASK << (pin << 1)));
-	mmio_setbits_32(base + GPIO_PUPD_OFFSET, pull << (pin << 1));
-
-	if (pin < GPIO_ALT_LOWER_LIMIT) {
-		mmio_clrbits_32(base + GPIO_AFRL_OFFSET,
-				((uint32_t)GPIO_ALTERNATE_MASK << (pin << 2)));
-		mmio_setbits_32(base + GPIO_AFRL_OFFSET,
-				alternate << (pin << 2));
-	} else {
-		mmio_clrbits_32(base + GPIO_AFRH_OFFSET,
-				((uint32_t)GPIO_ALTERNATE_MASK <<
-				 ((pin - GPIO_ALT_LOWER_LIMIT) << 2)));
-		mmio_setbits_32(base + GPIO_AFRH_OFFSET,
-				alternate << ((pin - GPIO_ALT_LOWER_LIMIT) <<
-					      2));
-	}
-
-	VERBOSE("GPIO %u mode set to 0x%x\n", bank,
-		mmio_read_32(base + GPIO_MODE_OFFSET));
-	VERBOSE("GPIO %u speed set to 0x%x\n", bank,
-		mmio_read_32(base + GPIO_SPEED_OFFSET));
-	VERBOSE("GPIO %u mode pull to 0x%x\n", bank,
-		mmio_read_32(base + GPIO_PUPD_OFFSET));
-	VERBOSE("GPIO %u mode alternate low to 0x%x\n", bank,
-		mmio_read_32(base + GPIO_AFRL_OFFSET));
-	VERBOSE("GPIO %u mode alternate high to 0x%x\n", bank,
-		mmio_read_32(base + GPIO_AFRH_OFFSET));
+	mmio_clrsetbits_32(base + GPIO_SECR_OFFSET, pins, secure & pins);
 
 	clk_disable(clock);
-
-	if (status == DT_SECURE) {
-		stm32mp_register_secure_gpio(bank, pin);
-		set_gpio_secure_cfg(bank, pin, true);
-
-	} else {
-		stm32mp_register_non_secure_gpio(bank, pin);
-		set_gpio_secure_cfg(bank, pin, false);
-	}
 }
 
 void set_gpio_secure_cfg(uint32_t bank, uint32_t pin, bool secure)
 {
-	uintptr_t base = stm32_get_gpio_bank_base(bank);
-	unsigned long clock = stm32_get_gpio_bank_clock(bank);
-
 	assert(pin <= GPIO_PIN_MAX);
 
-	clk_enable(clock);
-
-	if (secure) {
-		mmio_setbits_32(base + GPIO_SECR_OFFSET, BIT(pin));
-	} else {
-		mmio_clrbits_32(base + GPIO_SECR_OFFSET, BIT(pin));
-	}
-
-	clk_disable(clock);
+	set_gpio_bank_secure_cfg(bank, BIT(pin), secure ? BIT(pin) : 0U);
 }
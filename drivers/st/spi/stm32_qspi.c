@@ -12,6 +12,7 @@
 #include <common/fdt_wrappers.h>
 #include <drivers/clk.h>
 #include <drivers/delay_timer.h>
+#include <drivers/dma.h>
 #include <drivers/spi_mem.h>
 #include <drivers/st/stm32_gpio.h>
 #include <drivers/st/stm32_qspi.h>
@@ -178,6 +179,7 @@ static void stm32_qspi_write_fifo(uint8_t *val, uintptr_t addr)
 static int stm32_qspi_poll(const struct spi_mem_op *op)
 {
 	void (*fifo)(uint8_t *val, uintptr_t addr);
+	uint64_t timeout_cnt = timeout_cnt_us2cnt(QSPI_FIFO_TIMEOUT_US);
 	uint32_t len;
 	uint8_t *buf;
 
@@ -190,7 +192,7 @@ static int stm32_qspi_poll(const struct spi_mem_op *op)
 	buf = (uint8_t *)op->data.buf;
 
 	for (len = op->data.nbytes; len != 0U; len--) {
-		uint64_t timeout = timeout_init_us(QSPI_FIFO_TIMEOUT_US);
+		uint64_t timeout = timeout_init_cnt(timeout_cnt);
 
 		while ((mmio_read_32(qspi_base() + QSPI_SR) &
 			QSPI_SR_FTF) == 0U) {
@@ -208,9 +210,15 @@ static int stm32_qspi_poll(const struct spi_mem_op *op)
 
 static int stm32_qspi_mm(const struct spi_mem_op *op)
 {
+#if STM32MP_MDMA
+	dma_memcpy(op->data.buf,
+	       (void *)(stm32_qspi.mm_base + (size_t)op->addr.val),
+	       op->data.nbytes);
+#else
 	memcpy(op->data.buf,
 	       (void *)(stm32_qspi.mm_base + (size_t)op->addr.val),
 	       op->data.nbytes);
+#endif
 
 	return 0;
 }
@@ -429,8 +429,17 @@
 #define PMCR_LP_BIT		(U(1) << 7)
 #define PMCR_LC_BIT		(U(1) << 6)
 #define PMCR_DP_BIT		(U(1) << 5)
+#define PMCR_D_BIT		(U(1) << 3)
+#define PMCR_C_BIT		(U(1) << 2)
+#define PMCR_P_BIT		(U(1) << 1)
+#define PMCR_E_BIT		(U(1) << 0)
 #define	PMCR_RESET_VAL		U(0x0)
 
+/* PMCNTENSET/PMCNTENCLR/PMOVSR cycle counter bit */
+#define PMCNTEN_C_BIT		(U(1) << 31)
+/* PMSELR value selecting PMCCFILTR through PMXEVTYPER */
+#define PMSELR_CCFILTR		U(31)
+
 /*******************************************************************************
  * Definitions of register offsets, fields and macros for CPU system
  * instructions.
@@ -545,6 +554,13 @@
 /* Debug register defines. The format is: coproc, opt1, CRn, CRm, opt2 */
 #define HDCR		p15, 4, c1, c1, 1
 #define PMCR		p15, 0, c9, c12, 0
+#define PMCNTENSET	p15, 0, c9, c12, 1
+#define PMCNTENCLR	p15, 0, c9, c12, 2
+#define PMOVSR		p15, 0, c9, c12, 3
+#define PMSELR		p15, 0, c9, c12, 5
+#define PMCCNTR		p15, 0, c9, c13, 0
+#define PMXEVTYPER	p15, 0, c9, c13, 1
+#define PMXEVCNTR	p15, 0, c9, c13, 2
 #define CNTHP_TVAL	p15, 4, c14, c2, 0
 #define CNTHP_CTL	p15, 4, c14, c2, 1
 
@@ -287,7 +287,14 @@ DEFINE_COPROCR_WRITE_FUNC_64(icc_sgi1r, ICC_SGI1R_EL1_64)
 
 DEFINE_COPROCR_RW_FUNCS(hdcr, HDCR)
 DEFINE_COPROCR_RW_FUNCS(cnthp_ctl, CNTHP_CTL)
-DEFINE_COPROCR_READ_FUNC(pmcr, PMCR)
+DEFINE_COPROCR_RW_FUNCS(pmcr, PMCR)
+DEFINE_COPROCR_RW_FUNCS(pmcntenset, PMCNTENSET)
+DEFINE_COPROCR_WRITE_FUNC(pmcntenclr, PMCNTENCLR)
+DEFINE_COPROCR_RW_FUNCS(pmovsr, PMOVSR)
+DEFINE_COPROCR_RW_FUNCS(pmselr, PMSELR)
+DEFINE_COPROCR_RW_FUNCS(pmccntr, PMCCNTR)
+DEFINE_COPROCR_RW_FUNCS(pmxevtyper, PMXEVTYPER)
+DEFINE_COPROCR_RW_FUNCS(pmxevcntr, PMXEVCNTR)
 
 /*
  * Address translation
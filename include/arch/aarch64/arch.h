@@ -188,6 +188,10 @@
 #define ID_AA64DFR0_PMS_SHIFT	U(32)
 #define ID_AA64DFR0_PMS_MASK	ULL(0xf)
 
+/* ID_AA64ISAR0_EL1 definitions */
+#define ID_AA64ISAR0_CRC32_SHIFT	U(16)
+#define ID_AA64ISAR0_CRC32_MASK	ULL(0xf)
+
 /* ID_AA64ISAR1_EL1 definitions */
 #define ID_AA64ISAR1_EL1	S3_0_C0_C6_1
 #define ID_AA64ISAR1_GPI_SHIFT	U(28)
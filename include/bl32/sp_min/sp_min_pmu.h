@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SP_MIN_PMU_H
+#define SP_MIN_PMU_H
+
+#include <stdint.h>
+
+/* SMC function IDs tracked */
+#define SP_MIN_PMU_MAX_FIDS		16U
+
+/* Counters accumulated per SMC function ID */
+#define SP_MIN_PMU_CYCLES		0U
+#define SP_MIN_PMU_INSTRUCTIONS		1U
+#define SP_MIN_PMU_L1D_REFILLS		2U
+#define SP_MIN_PMU_L2D_REFILLS		3U
+#define SP_MIN_PMU_L1D_TLB_REFILLS	4U
+#define SP_MIN_PMU_NB_COUNTERS		5U
+
+struct sp_min_pmu_stats {
+	uint32_t smc_fid;
+	uint32_t calls;
+	uint64_t counter[SP_MIN_PMU_NB_COUNTERS];
+};
+
+/* Clear the statistics and start, or stop, accumulating them */
+void sp_min_pmu_stats_start(void);
+void sp_min_pmu_stats_stop(void);
+
+/* Number of SMC function IDs recorded since the last start */
+unsigned int sp_min_pmu_stats_count(void);
+
+/*
+ * Get the statistics of a recorded SMC function ID, summed over the cores.
+ * Returns 0, or -EINVAL for an index out of the recorded ones.
+ */
+int sp_min_pmu_stats_read(unsigned int index, struct sp_min_pmu_stats *stats);
+
+uintptr_t sp_min_pmu_handle_smc(uint32_t smc_fid, void *cookie, void *handle,
+				unsigned int flags);
+
+#endif /* SP_MIN_PMU_H */
@@ -157,6 +157,9 @@ typedef struct meminfo {
  * Function & variable prototypes
  ******************************************************************************/
 int load_auth_image(unsigned int image_id, image_info_t *image_data);
+int load_auth_image_parents(unsigned int image_id, image_info_t *cert_data);
+int auth_image_in_place(unsigned int image_id, image_info_t *image_data);
+void flush_image_dcache(uintptr_t base, size_t size);
 
 #if TRUSTED_BOARD_BOOT && defined(DYN_DISABLE_AUTH)
 /*
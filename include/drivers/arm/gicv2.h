@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2020, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -156,11 +156,43 @@ typedef struct gicv2_driver_data {
 	unsigned int interrupt_props_num;
 } gicv2_driver_data_t;
 
+/*******************************************************************************
+ * Register images of the SPI configuration, so that the distributor can be
+ * programmed with full register writes rather than with read-modify-write
+ * sequences for each interrupt. Arrays are provided by the caller and cover
+ * the first 'num_spis' SPIs, one bit, two bits or one byte per SPI:
+ *
+ * 'igroupr' has a bit set for each non-secure (Group 1) SPI.
+ * 'isenabler' has a bit set for each secure SPI to enable.
+ * 'icfgr' holds the trigger configuration, 'ipriorityr' the priority and
+ * 'itargetsr' the target CPU mask of each SPI.
+ *
+ * gicv2_spi_cfg_init() sets all SPIs to their default attributes, as done by
+ * gicv2_distif_init(), and gicv2_spi_cfg_set_secure() records a secure SPI.
+ ******************************************************************************/
+#define GICV2_SPI_CFG_WORDS(_num)	(((_num) + 31U) / 32U)
+#define GICV2_SPI_CFG_ICFGR_WORDS(_num)	(((_num) + 15U) / 16U)
+
+typedef struct gicv2_spi_cfg {
+	unsigned int num_spis;
+	uint32_t *igroupr;
+	uint32_t *isenabler;
+	uint32_t *icfgr;
+	uint8_t *ipriorityr;
+	uint8_t *itargetsr;
+} gicv2_spi_cfg_t;
+
 /*******************************************************************************
  * Function prototypes
  ******************************************************************************/
 void gicv2_driver_init(const gicv2_driver_data_t *plat_driver_data);
 void gicv2_distif_init(void);
+void gicv2_distif_init_spi_cfg(const gicv2_spi_cfg_t *spi_cfg);
+void gicv2_spi_cfg_init(gicv2_spi_cfg_t *spi_cfg);
+int gicv2_spi_cfg_set_secure(gicv2_spi_cfg_t *spi_cfg, unsigned int id,
+			     unsigned int pri, unsigned int cfg,
+			     unsigned int target);
+void gicv2_spi_cfg_apply_one(const gicv2_spi_cfg_t *spi_cfg, unsigned int id);
 void gicv2_pcpu_distif_init(void);
 void gicv2_cpuif_enable(void);
 void gicv2_cpuif_disable(void);
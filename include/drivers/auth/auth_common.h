@@ -58,6 +58,7 @@ typedef enum auth_method_type_enum {
 	AUTH_METHOD_HASH,	/* Authenticate by hash matching */
 	AUTH_METHOD_SIG,	/* Authenticate by PK operation */
 	AUTH_METHOD_NV_CTR,	/* Authenticate by Non-Volatile Counter */
+	AUTH_METHOD_HASH_LIST,	/* Authenticate by per-chunk hash matching */
 	AUTH_METHOD_NUM 	/* Number of methods */
 } auth_method_type_t;
 
@@ -69,6 +70,14 @@ typedef struct auth_method_param_hash_s {
 	auth_param_type_desc_t *hash;	/* Hash to match with */
 } auth_method_param_hash_t;
 
+/*
+ * Parameters for authentication by matching the hashes of successive chunks
+ */
+typedef struct auth_method_param_hash_list_s {
+	auth_param_type_desc_t *data;		/* Data to hash */
+	auth_param_type_desc_t *hash_list;	/* Chunk hashes to match with */
+} auth_method_param_hash_list_t;
+
 /*
  * Parameters for authentication by signature
  */
@@ -96,6 +105,7 @@ typedef struct auth_method_desc_s {
 		auth_method_param_hash_t hash;
 		auth_method_param_sig_t sig;
 		auth_method_param_nv_ctr_t nv_ctr;
+		auth_method_param_hash_list_t hash_list;
 	} param;
 } auth_method_desc_t;
 
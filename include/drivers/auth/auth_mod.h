@@ -48,9 +48,20 @@ typedef struct auth_img_desc_s {
 /* Public functions */
 void auth_mod_init(void);
 int auth_mod_get_parent_id(unsigned int img_id, unsigned int *parent_id);
+int auth_mod_get_img_hash(unsigned int img_id, void **hash_ptr,
+			  unsigned int *hash_len);
 int auth_mod_verify_img(unsigned int img_id,
 			void *img_ptr,
 			unsigned int img_len);
+#ifdef IMAGE_BL1
+int auth_mod_stream_start(unsigned int img_id, void *img_ptr);
+void auth_mod_stream_update(unsigned int img_id, const void *data_ptr,
+			    unsigned int data_len);
+void auth_mod_stream_abort(unsigned int img_id);
+#endif
+int auth_mod_get_chunk_size(unsigned int img_id, unsigned int *chunk_size);
+int auth_mod_verify_chunk(unsigned int img_id, unsigned int idx,
+			  void *chunk_ptr, unsigned int chunk_len);
 
 /* Macro to register a CoT defined as an array of auth_img_desc_t pointers */
 #define REGISTER_COT(_cot) \
@@ -107,4 +107,44 @@ int crypto_mod_calc_hash(unsigned int alg, void *data_ptr,
 
 extern const crypto_lib_desc_t crypto_lib_desc;
 
+#ifdef IMAGE_BL1
+/*
+ * Incremental hash calculation, optionally provided by the cryptographic
+ * library. Only BL1 uses it, to hash FWU images while they are copied. The data is hashed block by block as it becomes available, with the
+ * library's default digest algorithm, and the final digest is compared with the
+ * expected one afterwards.
+ */
+typedef struct crypto_hash_stream_desc_s {
+	/* Start a new hash calculation, discarding any previous one */
+	int (*start)(void);
+
+	/* Add a block of data to the current hash calculation */
+	int (*update)(const void *data_ptr, unsigned int data_len);
+
+	/*
+	 * Finalize the hash and compare it with the DER encoded digest info.
+	 * Return CRYPTO_ERR_UNKNOWN if the digest algorithm differs from the
+	 * one used for the calculation, so that the caller can hash the data
+	 * in one go instead. Otherwise return one of the
+	 * 'enum crypto_ret_value' options.
+	 */
+	int (*verify)(void *digest_info_ptr, unsigned int digest_info_len);
+} crypto_hash_stream_desc_t;
+
+int crypto_mod_hash_stream_start(void);
+int crypto_mod_hash_stream_update(const void *data_ptr, unsigned int data_len);
+int crypto_mod_hash_stream_verify(void *digest_info_ptr,
+				  unsigned int digest_info_len);
+
+/* Macro to register the incremental hash functions of a crypto library */
+#define REGISTER_CRYPTO_HASH_STREAM(_start, _update, _verify) \
+	const crypto_hash_stream_desc_t crypto_hash_stream_desc = { \
+		.start = _start, \
+		.update = _update, \
+		.verify = _verify \
+	}
+
+extern const crypto_hash_stream_desc_t crypto_hash_stream_desc;
+#endif /* IMAGE_BL1 */
+
 #endif /* CRYPTO_MOD_H */
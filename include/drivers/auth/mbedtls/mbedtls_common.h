@@ -8,5 +8,6 @@
 #define MBEDTLS_COMMON_H
 
 void mbedtls_init(void);
+void mbedtls_sha_neon_self_test(void);
 
 #endif /* MBEDTLS_COMMON_H */
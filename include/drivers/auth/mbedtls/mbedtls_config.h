@@ -75,6 +75,10 @@
 #define MBEDTLS_SHA512_C
 #endif
 
+#if TF_MBEDTLS_SHA_NEON
+#define MBEDTLS_SHA512_PROCESS_ALT
+#endif
+
 #define MBEDTLS_VERSION_C
 
 #define MBEDTLS_X509_USE_C
@@ -29,16 +29,25 @@ typedef struct timer_ops {
 
 static inline uint64_t timeout_cnt_us2cnt(uint32_t us)
 {
-	return ((uint64_t)us * (uint64_t)read_cntfrq_el0()) / 1000000ULL;
+	uint32_t freq = (uint32_t)read_cntfrq_el0();
+
+	/* Avoid a 64-bit division for the usual whole MHz frequencies */
+	if ((freq % 1000000U) == 0U) {
+		return (uint64_t)us * (freq / 1000000U);
+	}
+
+	return ((uint64_t)us * freq) / 1000000ULL;
 }
 
-static inline uint64_t timeout_init_us(uint32_t us)
+/* Deadline after a duration already converted with timeout_cnt_us2cnt() */
+static inline uint64_t timeout_init_cnt(uint64_t cnt)
 {
-	uint64_t cnt = timeout_cnt_us2cnt(us);
-
-	cnt += read_cntpct_el0();
+	return read_cntpct_el0() + cnt;
+}
 
-	return cnt;
+static inline uint64_t timeout_init_us(uint32_t us)
+{
+	return timeout_init_cnt(timeout_cnt_us2cnt(us));
 }
 
 static inline bool timeout_elapsed(uint64_t expire_cnt)
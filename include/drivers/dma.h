@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2020, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef DMA_H
+#define DMA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Memory to memory transfers offloaded to a DMA engine.
+ *
+ * The engine is not coherent with the data cache: the source and the
+ * destination are cleaned before the transfer starts and the destination is
+ * invalidated once it completes. Until dma_wait() returns, the CPU must not
+ * write the source, nor access the destination or data sharing a cache line
+ * with its edges.
+ *
+ * Transfers shorter than the engine min_len, or that the engine cannot do,
+ * are done by the CPU before the *_async() call returns.
+ */
+typedef struct dma_xfer {
+	uintptr_t dst;
+	uintptr_t src;
+	size_t len;
+	uint8_t value;
+	bool fill;
+	int chan;	/* Engine channel, negative once done */
+} dma_xfer_t;
+
+typedef struct dma_ops {
+	/* Return the channel running the transfer or a negative errno */
+	int (*copy)(uintptr_t dst, uintptr_t src, size_t len);
+	int (*fill)(uintptr_t dst, uint8_t value, size_t len);
+	/* Wait for the transfer and release the channel */
+	int (*wait)(int chan);
+	size_t min_len;
+} dma_ops_t;
+
+void dma_memcpy_async(dma_xfer_t *xfer, void *dst, const void *src,
+		      size_t len);
+void dma_memset_async(dma_xfer_t *xfer, void *dst, int value, size_t len);
+void dma_wait(dma_xfer_t *xfer);
+
+void *dma_memcpy(void *dst, const void *src, size_t len);
+void *dma_memset(void *dst, int value, size_t len);
+
+void dma_benchmark(uintptr_t scratch, size_t size);
+
+void dma_register(const dma_ops_t *ops);
+
+#endif /* DMA_H */
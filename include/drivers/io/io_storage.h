@@ -84,6 +84,26 @@ int io_dev_init(uintptr_t dev_handle, const uintptr_t init_params);
 /* Close a connection to a device */
 int io_dev_close(uintptr_t dev_handle);
 
+/*
+ * Keep device connections open, and devices initialised, from
+ * io_session_begin() to io_session_end(). io_session_flush() drops the
+ * connections so that devices are initialised again on their next use.
+ */
+void io_session_begin(void);
+void io_session_end(void);
+void io_session_flush(void);
+
+/* Counters of device and entity operations since boot */
+typedef struct io_stats {
+	unsigned int dev_init;
+	unsigned int dev_close;
+	unsigned int open;
+	unsigned int read[IO_TYPE_MAX];
+	unsigned long long read_bytes[IO_TYPE_MAX];
+} io_stats_t;
+
+const io_stats_t *io_get_stats(void);
+
 
 /* Synchronous operations */
 int io_open(uintptr_t dev_handle, const uintptr_t spec, uintptr_t *handle);
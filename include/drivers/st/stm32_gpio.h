@@ -52,6 +52,7 @@ int dt_set_pinctrl_config(int node);
 void set_gpio(uint32_t bank, uint32_t pin, uint32_t mode, uint32_t speed,
 	      uint32_t pull, uint32_t alternate, uint8_t status);
 void set_gpio_secure_cfg(uint32_t bank, uint32_t pin, bool secure);
+void set_gpio_bank_secure_cfg(uint32_t bank, uint32_t pins, uint32_t secure);
 #endif /*__ASSEMBLER__*/
 
 #endif /* STM32_GPIO_H */
@@ -0,0 +1,14 @@
+/*
+ * Copyright (c) 2020, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef STM32_MDMA_H
+#define STM32_MDMA_H
+
+#include <stdint.h>
+
+int stm32_mdma_init(uint32_t channels);
+
+#endif /* STM32_MDMA_H */
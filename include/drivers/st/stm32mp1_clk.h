@@ -35,6 +35,7 @@ int stm32mp1_clk_get_maxfreq_opp(uint32_t *freq_mhz, uint32_t *voltage_mv);
 
 bool stm32mp1_rcc_is_secure(void);
 bool stm32mp1_rcc_is_mckprot(void);
+bool stm32mp1_clk_rate_is_secure(unsigned long id);
 
 void stm32mp1_clk_force_enable(unsigned long id);
 void stm32mp1_clk_force_disable(unsigned long id);
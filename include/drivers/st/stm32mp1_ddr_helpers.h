@@ -17,6 +17,12 @@ enum stm32mp1_ddr_sr_mode {
 	DDR_ASR_MODE,
 };
 
+/* Boot QoS settings and up to 3 st,ctl-perf-profiles from the DT */
+#define DDR_QOS_PROFILE_MAX	4U
+
+/* DDRPERFM time counter, after the 4 event counters */
+#define DDR_PERF_CNT_TIME	4U
+
 void ddr_enable_clock(void);
 int ddr_sw_self_refresh_exit(void);
 uint32_t ddr_get_io_calibration_val(void);
@@ -26,5 +32,12 @@ void ddr_set_sr_mode(enum stm32mp1_ddr_sr_mode mode);
 void ddr_save_sr_mode(void);
 void ddr_restore_sr_mode(void);
 bool ddr_is_nonsecured_area(uintptr_t address, uint32_t length);
+int ddr_qos_init(void);
+unsigned int ddr_qos_get_profile_nb(void);
+unsigned int ddr_qos_get_profile(void);
+int ddr_qos_set_profile(unsigned int id);
+void ddr_perf_start(void);
+void ddr_perf_stop(void);
+int ddr_perf_read(unsigned int counter, uint32_t *value);
 
 #endif /* STM32MP1_DDR_HELPERS_H */
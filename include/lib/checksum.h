@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Checksum service.
+ *
+ * CRC32 (IEEE 802.3, as used by gzip and GPT) and CRC32C (Castagnoli) follow
+ * the zlib crc32() convention: the seed is a previously returned value, 0U
+ * for a new computation, so that a CRC can be computed in several chunks.
+ *
+ * The CRCs are computed by a hardware backend when one is available, either
+ * registered by the platform with checksum_init() or provided by the
+ * architecture, and by a sliced-table software implementation otherwise.
+ ******************************************************************************/
+
+typedef struct checksum_ops {
+	/* Both handlers are optional, NULL falls back to software */
+	uint32_t (*crc32)(uint32_t crc, const uint8_t *buf, size_t len);
+	uint32_t (*crc32c)(uint32_t crc, const uint8_t *buf, size_t len);
+} checksum_ops_t;
+
+void checksum_init(const checksum_ops_t *ops_ptr);
+
+/* Return the architecture CRC backend, or NULL if there is none */
+const checksum_ops_t *checksum_arch_ops(void);
+
+uint32_t checksum_crc32(uint32_t crc, const void *buf, size_t len);
+uint32_t checksum_crc32c(uint32_t crc, const void *buf, size_t len);
+
+/* Sum of all bytes, added to sum */
+uint32_t checksum_add8(uint32_t sum, const void *buf, size_t len);
+
+/* Exclusive OR of all bytes, combined with xor */
+uint8_t checksum_xor8(uint8_t xor, const void *buf, size_t len);
+
+#endif /* CHECKSUM_H */
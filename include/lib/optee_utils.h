@@ -7,11 +7,42 @@
 #ifndef OPTEE_UTILS_H
 #define OPTEE_UTILS_H
 
+#include <stdint.h>
+
 #include <common/bl_common.h>
 
+#define OPTEE_PAGED_DESC_MAGIC		U(0x44504554) /* "TEPD" */
+#define OPTEE_PAGED_DESC_VERSION	U(1)
+#define OPTEE_PAGED_HASH_MAX_LEN	U(96)
+
+/*
+ * Descriptor of the OP-TEE pageable part when it is left in storage, for the
+ * secure OS to load it later (OPTEE_DEFER_PAGED_LOAD).
+ * load_addr and size: where the pager expects the pageable part.
+ * storage_id: platform defined identifier of the storage device.
+ * storage_offset: offset of the pageable part on the storage device.
+ * hash_len and hash: DER encoded DigestInfo of the pageable part taken from
+ *	the authenticated chain of trust, hash_len is 0 if there is none.
+ */
+typedef struct optee_paged_desc {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t load_addr;
+	uint64_t size;
+	uint64_t storage_offset;
+	uint32_t storage_id;
+	uint32_t hash_len;
+	uint8_t hash[OPTEE_PAGED_HASH_MAX_LEN];
+} optee_paged_desc_t;
+
 int get_optee_header_ep(entry_point_info_t *header_ep, uintptr_t *pc);
 int parse_optee_header(entry_point_info_t *header_ep,
 	image_info_t *pager_image_info,
 	image_info_t *paged_image_info);
+#if OPTEE_DEFER_PAGED_LOAD
+int optee_defer_paged_image(unsigned int image_id,
+	const image_info_t *paged_image_info,
+	optee_paged_desc_t *desc);
+#endif
 
 #endif /* OPTEE_UTILS_H */
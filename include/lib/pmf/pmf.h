@@ -35,6 +35,20 @@
 #define PMF_CACHE_MAINT		(U(1) << 0)
 #define PMF_NO_CACHE_MAINT	U(0)
 
+/*
+ * Flags passed to PMF_GET_TIMESTAMP_XXX to read the ring buffers instead of
+ * the latest timestamp, when PMF_RING_DEPTH is not 0. PMF_RING_SAMPLE(n)
+ * reads the n-th previous capture, 0 being the latest one, and returns 0 if
+ * it is not in the ring. PMF_RING_COUNT returns the number of captures.
+ */
+#define PMF_RING_READ		(U(1) << 1)
+#define PMF_RING_COUNT		(U(1) << 2)
+#define PMF_RING_SAMPLE_SHIFT	8
+#define PMF_RING_SAMPLE_MASK	(U(0xFF) << PMF_RING_SAMPLE_SHIFT)
+#define PMF_RING_SAMPLE(_n)	(PMF_RING_READ |			\
+				 (((_n) << PMF_RING_SAMPLE_SHIFT) &	\
+				  PMF_RING_SAMPLE_MASK))
+
 /*
  * Defines for PMF SMC function ids.
  */
@@ -63,6 +77,7 @@ int pmf_get_timestamp_smc(unsigned int tid,
 		unsigned int flags,
 		unsigned long long *ts_value);
 int pmf_setup(void);
+void pmf_flush_my_timestamps(void);
 uintptr_t pmf_smc_handler(unsigned int smc_fid,
 		u_register_t x1,
 		u_register_t x2,
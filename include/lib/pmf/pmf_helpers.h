@@ -43,6 +43,17 @@ typedef struct pmf_svc_desc {
 	pmf_svc_get_ts_t get_ts;
 } pmf_svc_desc_t;
 
+#if PMF_RING_DEPTH
+/*
+ * Per-CPU ring of the last PMF_RING_DEPTH captures of a timestamp, written
+ * without cache maintenance.
+ */
+typedef struct pmf_ring {
+	unsigned long long count;
+	unsigned long long ts[PMF_RING_DEPTH];
+} pmf_ring_t;
+#endif
+
 #if ENABLE_PMF
 /*
  * Convenience macros for capturing time-stamp.
@@ -155,8 +166,36 @@ typedef struct pmf_svc_desc {
 	unsigned long long pmf_ts_mem_ ## _name[_total_id]	\
 	__aligned(CACHE_WRITEBACK_GRANULE)			\
 	__section("pmf_timestamp_array")			\
+	__used;							\
+	PMF_ALLOCATE_RING_MEMORY(_name, _total_id)
+
+/*
+ * Ring buffers of a PMF service, in the same per-CPU region as its latest
+ * timestamps. Captures go to both.
+ */
+#if PMF_RING_DEPTH
+#define PMF_ALLOCATE_RING_MEMORY(_name, _total_id)		\
+	extern pmf_ring_t pmf_ring_mem_ ## _name[_total_id];	\
+	pmf_ring_t pmf_ring_mem_ ## _name[_total_id]		\
+	__section("pmf_timestamp_array")			\
 	__used;
 
+#define PMF_STORE_RING(_name, _tid, _ts)			\
+	__pmf_store_ring_timestamp((uintptr_t)pmf_ring_mem_ ## _name, \
+		(_tid), (_ts))
+
+#define PMF_GET_TS(_name, _base, _tid, _cpuid, _flags)		\
+	((((_flags) & (PMF_RING_READ | PMF_RING_COUNT)) != 0U) ?	\
+	 __pmf_get_ring_timestamp((uintptr_t)pmf_ring_mem_ ## _name, \
+		(_tid), (_cpuid), (_flags)) :			\
+	 __pmf_get_timestamp((_base), (_tid), (_cpuid), (_flags)))
+#else
+#define PMF_ALLOCATE_RING_MEMORY(_name, _total_id)
+#define PMF_STORE_RING(_name, _tid, _ts)	((void)0)
+#define PMF_GET_TS(_name, _base, _tid, _cpuid, _flags)		\
+	__pmf_get_timestamp((_base), (_tid), (_cpuid), (_flags))
+#endif /* PMF_RING_DEPTH */
+
 /*
  * Convenience macro to validate tid index for the given TS array.
  */
@@ -176,9 +215,11 @@ typedef struct pmf_svc_desc {
 		CASSERT(_flags != 0, select_proper_config);		\
 		PMF_VALIDATE_TID(_name, (uint64_t)tid);			\
 		uintptr_t base_addr = (uintptr_t) pmf_ts_mem_ ## _name;	\
-		if (((_flags) & PMF_STORE_ENABLE) != 0)			\
+		if (((_flags) & PMF_STORE_ENABLE) != 0) {		\
 			__pmf_store_timestamp(base_addr,		\
 				(uint64_t)tid, ts);			\
+			PMF_STORE_RING(_name, (uint64_t)tid, ts);	\
+		}							\
 		if (((_flags) & PMF_DUMP_ENABLE) != 0)			\
 			__pmf_dump_timestamp((uint64_t)tid, ts);	\
 	}								\
@@ -189,9 +230,16 @@ typedef struct pmf_svc_desc {
 		CASSERT(_flags != 0, select_proper_config);		\
 		PMF_VALIDATE_TID(_name, (uint64_t)tid);			\
 		uintptr_t base_addr = (uintptr_t) pmf_ts_mem_ ## _name;	\
-		if (((_flags) & PMF_STORE_ENABLE) != 0)			\
+		if ((((_flags) & PMF_STORE_ENABLE) != 0) &&		\
+		    (PMF_RING_DEPTH != 0)) {				\
+			/* Cleaned by pmf_flush_my_timestamps() */	\
+			__pmf_store_timestamp(base_addr,		\
+				(uint64_t)tid, ts);			\
+			PMF_STORE_RING(_name, (uint64_t)tid, ts);	\
+		} else if (((_flags) & PMF_STORE_ENABLE) != 0) {	\
 			__pmf_store_timestamp_with_cache_maint(		\
 				base_addr, (uint64_t)tid, ts);		\
+		}							\
 		if (((_flags) & PMF_DUMP_ENABLE) != 0)			\
 			__pmf_dump_timestamp((uint64_t)tid, ts);	\
 	}
@@ -207,14 +255,14 @@ typedef struct pmf_svc_desc {
 	{								\
 		PMF_VALIDATE_TID(_name, tid);				\
 		uintptr_t base_addr = (uintptr_t) pmf_ts_mem_ ## _name;	\
-		return __pmf_get_timestamp(base_addr, tid, cpuid, flags);\
+		return PMF_GET_TS(_name, base_addr, tid, cpuid, flags);	\
 	}								\
 	unsigned long long pmf_get_timestamp_by_mpidr_ ## _name(	\
 		unsigned int tid, u_register_t mpidr, unsigned int flags)\
 	{								\
 		PMF_VALIDATE_TID(_name, tid);				\
 		uintptr_t base_addr = (uintptr_t) pmf_ts_mem_ ## _name;	\
-		return __pmf_get_timestamp(base_addr, tid,		\
+		return PMF_GET_TS(_name, base_addr, tid,		\
 			plat_core_pos_by_mpidr(mpidr), flags);		\
 	}
 
@@ -253,4 +301,11 @@ unsigned long long __pmf_get_timestamp(uintptr_t base_addr,
 		unsigned int tid,
 		unsigned int cpuid,
 		unsigned int flags);
+void __pmf_store_ring_timestamp(uintptr_t ring_base,
+		unsigned int tid,
+		unsigned long long ts);
+unsigned long long __pmf_get_ring_timestamp(uintptr_t ring_base,
+		unsigned int tid,
+		unsigned int cpuid,
+		unsigned int flags);
 #endif /* PMF_HELPERS_H */
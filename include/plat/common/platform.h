@@ -210,6 +210,10 @@ int bl2_plat_handle_post_image_load(unsigned int image_id);
 /* Read TCG_DIGEST_SIZE bytes of BL2 hash data */
 void bl2_plat_get_hash(void *data);
 #endif
+#if OPTEE_DEFER_PAGED_LOAD
+int plat_get_image_storage_location(unsigned int image_id,
+				    uint32_t *storage_id, uint64_t *offset);
+#endif
 
 /*******************************************************************************
  * Mandatory BL2 at EL3 functions: Must be implemented if BL2_AT_EL3 image is
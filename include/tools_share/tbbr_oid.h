@@ -147,6 +147,8 @@
 #define NON_TRUSTED_WORLD_BOOTLOADER_HASH_OID	"1.3.6.1.4.1.4128.2100.1201"
 /* NonTrustedFirmwareConfigHash - NT_FW_CONFIG */
 #define NON_TRUSTED_FW_CONFIG_HASH_OID		"1.3.6.1.4.1.4128.2100.1202"
+/* NonTrustedWorldBootloaderChunkHashes - BL33 hashed in chunks */
+#define NON_TRUSTED_WORLD_BOOTLOADER_CHUNK_HASHES_OID	"1.3.6.1.4.1.4128.2100.1203"
 
 /*
  * Secure Partitions Content Certificate
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <arch.h>
+#include <arch_helpers.h>
+#include <lib/checksum.h>
+
+/*
+ * CRC32 instructions are optional in Armv8.0, so they are enabled for these
+ * helpers only and used after ID_AA64ISAR0_EL1 has been checked.
+ */
+#define DEFINE_CRC32_INSN(_name, _insn, _reg, _type)			\
+static inline uint32_t _name(uint32_t crc, _type data)			\
+{									\
+	__asm__ (".arch_extension crc\n"				\
+		 #_insn " %w0, %w0, %" #_reg "1"			\
+		 : "+r" (crc) : "r" (data));				\
+	return crc;							\
+}
+
+DEFINE_CRC32_INSN(crc32b, crc32b, w, uint8_t)
+DEFINE_CRC32_INSN(crc32x, crc32x, x, uint64_t)
+DEFINE_CRC32_INSN(crc32cb, crc32cb, w, uint8_t)
+DEFINE_CRC32_INSN(crc32cx, crc32cx, x, uint64_t)
+
+typedef uint64_t __attribute__((__may_alias__)) crc32_dword_t;
+
+#define DEFINE_CRC32_FUNC(_name, _byte, _dword)				\
+static uint32_t _name(uint32_t crc, const uint8_t *buf, size_t len)	\
+{									\
+	crc = ~crc;							\
+									\
+	while ((len != 0U) && (((uintptr_t)buf & 7U) != 0U)) {		\
+		crc = _byte(crc, *buf++);				\
+		len--;							\
+	}								\
+									\
+	while (len >= sizeof(uint64_t)) {				\
+		crc = _dword(crc, *(const crc32_dword_t *)buf);		\
+		buf += sizeof(uint64_t);				\
+		len -= sizeof(uint64_t);				\
+	}								\
+									\
+	while (len != 0U) {						\
+		crc = _byte(crc, *buf++);				\
+		len--;							\
+	}								\
+									\
+	return ~crc;							\
+}
+
+DEFINE_CRC32_FUNC(armv8_crc32, crc32b, crc32x)
+DEFINE_CRC32_FUNC(armv8_crc32c, crc32cb, crc32cx)
+
+static const checksum_ops_t armv8_crc32_ops = {
+	.crc32 = armv8_crc32,
+	.crc32c = armv8_crc32c,
+};
+
+const checksum_ops_t *checksum_arch_ops(void)
+{
+	if (((read_id_aa64isar0_el1() >> ID_AA64ISAR0_CRC32_SHIFT) &
+	     ID_AA64ISAR0_CRC32_MASK) == 0U) {
+		return NULL;
+	}
+
+	return &armv8_crc32_ops;
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <lib/checksum.h>
+#include <lib/utils_def.h>
+
+/* Reflected polynomials */
+#define CRC32_POLY		U(0xEDB88320)
+#define CRC32C_POLY		U(0x82F63B78)
+
+/* Number of table lookups per 32-bit word in the software CRC */
+#define CRC_SLICES		4U
+
+/*
+ * Bytes summed in 16-bit lanes before folding in checksum_add8(): each word
+ * adds at most 2 * 0xFF to a lane, so 128 words cannot overflow it.
+ */
+#define ADD8_FOLD_WORDS		((size_t)128U)
+
+typedef uint32_t __attribute__((__may_alias__)) checksum_word_t;
+
+struct crc_sw_table {
+	uint32_t poly;
+	bool ready;
+	uint32_t entry[CRC_SLICES][256];
+};
+
+static struct crc_sw_table crc32_table = { .poly = CRC32_POLY };
+static struct crc_sw_table crc32c_table = { .poly = CRC32C_POLY };
+
+static const checksum_ops_t *ops;
+static bool ops_resolved;
+
+#pragma weak checksum_arch_ops
+const checksum_ops_t *checksum_arch_ops(void)
+{
+	return NULL;
+}
+
+/*
+ * Register the CRC backend. A NULL ops_ptr selects the architecture backend
+ * if any, and the software implementation otherwise.
+ */
+void checksum_init(const checksum_ops_t *ops_ptr)
+{
+	ops = (ops_ptr != NULL) ? ops_ptr : checksum_arch_ops();
+	ops_resolved = true;
+}
+
+static const checksum_ops_t *get_ops(void)
+{
+	if (!ops_resolved) {
+		checksum_init(NULL);
+	}
+
+	return ops;
+}
+
+/*
+ * The tables are built on first use rather than stored in the image. A
+ * concurrent first use only writes the same values twice.
+ */
+static void crc_sw_table_init(struct crc_sw_table *table)
+{
+	unsigned int i, j;
+
+	for (i = 0U; i < 256U; i++) {
+		uint32_t crc = i;
+
+		for (j = 0U; j < 8U; j++) {
+			crc = (crc >> 1) ^
+			      (((crc & 1U) != 0U) ? table->poly : 0U);
+		}
+
+		table->entry[0][i] = crc;
+	}
+
+	for (i = 0U; i < 256U; i++) {
+		uint32_t crc = table->entry[0][i];
+
+		for (j = 1U; j < CRC_SLICES; j++) {
+			crc = table->entry[0][crc & 0xFFU] ^ (crc >> 8);
+			table->entry[j][i] = crc;
+		}
+	}
+
+	table->ready = true;
+}
+
+static uint32_t crc_sw(struct crc_sw_table *table, uint32_t crc,
+		       const uint8_t *buf, size_t len)
+{
+	if (!table->ready) {
+		crc_sw_table_init(table);
+	}
+
+	crc = ~crc;
+
+	while ((len != 0U) && (((uintptr_t)buf & 3U) != 0U)) {
+		crc = table->entry[0][(crc ^ *buf++) & 0xFFU] ^ (crc >> 8);
+		len--;
+	}
+
+	/* Little-endian word: the first byte is in the low bits */
+	while (len >= sizeof(uint32_t)) {
+		crc ^= *(const checksum_word_t *)buf;
+		crc = table->entry[3][crc & 0xFFU] ^
+		      table->entry[2][(crc >> 8) & 0xFFU] ^
+		      table->entry[1][(crc >> 16) & 0xFFU] ^
+		      table->entry[0][crc >> 24];
+		buf += sizeof(uint32_t);
+		len -= sizeof(uint32_t);
+	}
+
+	while (len != 0U) {
+		crc = table->entry[0][(crc ^ *buf++) & 0xFFU] ^ (crc >> 8);
+		len--;
+	}
+
+	return ~crc;
+}
+
+uint32_t checksum_crc32(uint32_t crc, const void *buf, size_t len)
+{
+	const checksum_ops_t *crc_ops = get_ops();
+
+	if ((crc_ops != NULL) && (crc_ops->crc32 != NULL)) {
+		return crc_ops->crc32(crc, buf, len);
+	}
+
+	return crc_sw(&crc32_table, crc, buf, len);
+}
+
+uint32_t checksum_crc32c(uint32_t crc, const void *buf, size_t len)
+{
+	const checksum_ops_t *crc_ops = get_ops();
+
+	if ((crc_ops != NULL) && (crc_ops->crc32c != NULL)) {
+		return crc_ops->crc32c(crc, buf, len);
+	}
+
+	return crc_sw(&crc32c_table, crc, buf, len);
+}
+
+uint32_t checksum_add8(uint32_t sum, const void *buf, size_t len)
+{
+	const uint8_t *p = buf;
+
+	while ((len != 0U) && (((uintptr_t)p & 3U) != 0U)) {
+		sum += *p++;
+		len--;
+	}
+
+	/* Sum pairs of bytes in two 16-bit lanes per word */
+	while (len >= sizeof(uint32_t)) {
+		size_t words = MIN(len / sizeof(uint32_t), ADD8_FOLD_WORDS);
+		uint32_t lanes = 0U;
+
+		len -= words * sizeof(uint32_t);
+
+		while (words-- != 0U) {
+			uint32_t word = *(const checksum_word_t *)p;
+
+			lanes += (word & 0x00FF00FFU) +
+				 ((word >> 8) & 0x00FF00FFU);
+			p += sizeof(uint32_t);
+		}
+
+		sum += (lanes & 0xFFFFU) + (lanes >> 16);
+	}
+
+	while (len != 0U) {
+		sum += *p++;
+		len--;
+	}
+
+	return sum;
+}
+
+uint8_t checksum_xor8(uint8_t xor, const void *buf, size_t len)
+{
+	const uint8_t *p = buf;
+	uint32_t word_xor = 0U;
+
+	while ((len != 0U) && (((uintptr_t)p & 3U) != 0U)) {
+		xor ^= *p++;
+		len--;
+	}
+
+	while (len >= sizeof(uint32_t)) {
+		word_xor ^= *(const checksum_word_t *)p;
+		p += sizeof(uint32_t);
+		len -= sizeof(uint32_t);
+	}
+
+	while (len != 0U) {
+		xor ^= *p++;
+		len--;
+	}
+
+	word_xor ^= word_xor >> 16;
+	word_xor ^= word_xor >> 8;
+
+	return xor ^ (uint8_t)word_xor;
+}
@@ -0,0 +1,11 @@
+#
+# Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+CHECKSUM_SOURCES	:=	lib/checksum/checksum.c
+
+ifeq (${ARCH},aarch64)
+CHECKSUM_SOURCES	+=	lib/checksum/aarch64/checksum_crc32.c
+endif
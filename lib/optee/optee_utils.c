@@ -5,9 +5,14 @@
  */
 
 #include <assert.h>
+#include <string.h>
 
+#include <arch_helpers.h>
 #include <common/debug.h>
+#include <drivers/auth/auth_mod.h>
 #include <lib/optee_utils.h>
+#include <lib/utils.h>
+#include <plat/common/platform.h>
 
 /*
  * load_addr_hi and load_addr_lo: image load address.
@@ -231,6 +236,11 @@ int parse_optee_header(entry_point_info_t *header_ep,
 			return -1;
 	}
 
+#if OPTEE_DEFER_PAGED_LOAD
+	/* The pageable part is loaded by OP-TEE, see optee_defer_paged_image() */
+	paged_image_info->h.attr |= IMAGE_ATTRIB_SKIP_LOADING;
+#endif
+
 	/*
 	 * Update "pc" value which should comes from pager image. After the
 	 * header image is parsed, it will be unuseful, and the actual
@@ -260,3 +270,60 @@ int parse_optee_header(entry_point_info_t *header_ep,
 
 	return 0;
 }
+
+#if OPTEE_DEFER_PAGED_LOAD
+/*******************************************************************************
+ * Fill the descriptor that lets OP-TEE load its pageable part, left in storage
+ * by BL2, once the chain of trust of the pageable part is authenticated.
+ * Return 0 on success or a negative error code otherwise.
+ ******************************************************************************/
+int optee_defer_paged_image(unsigned int image_id,
+		const image_info_t *paged_image_info,
+		optee_paged_desc_t *desc)
+{
+	uint64_t offset;
+	uint32_t storage_id;
+	int ret;
+
+	assert((paged_image_info != NULL) && (desc != NULL));
+
+	ret = plat_get_image_storage_location(image_id, &storage_id, &offset);
+	if (ret != 0) {
+		ERROR("OPTEE pageable part location not found (%i)\n", ret);
+		return ret;
+	}
+
+	zeromem(desc, sizeof(*desc));
+	desc->magic = OPTEE_PAGED_DESC_MAGIC;
+	desc->version = OPTEE_PAGED_DESC_VERSION;
+	desc->load_addr = paged_image_info->image_base;
+	desc->size = paged_image_info->image_size;
+	desc->storage_offset = offset;
+	desc->storage_id = storage_id;
+
+#if TRUSTED_BOARD_BOOT
+	{
+		void *hash_ptr;
+		unsigned int hash_len;
+
+		if (auth_mod_get_img_hash(image_id, &hash_ptr,
+					  &hash_len) == 0) {
+			if (hash_len > sizeof(desc->hash)) {
+				ERROR("OPTEE pageable part hash too long\n");
+				return -1;
+			}
+
+			memcpy(desc->hash, hash_ptr, hash_len);
+			desc->hash_len = hash_len;
+		}
+	}
+#endif
+
+	INFO("OPTEE pageable part left at 0x%llx on storage %u\n",
+	     (unsigned long long)desc->storage_offset, desc->storage_id);
+
+	flush_dcache_range((uintptr_t)desc, sizeof(*desc));
+
+	return 0;
+}
+#endif /* OPTEE_DEFER_PAGED_LOAD */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2020, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -249,8 +249,93 @@ unsigned long long __pmf_get_timestamp(uintptr_t base_addr,
 	unsigned long long *ts_addr = (unsigned long long *)calc_ts_addr(base_addr,
 				tid, cpuid);
 
-	if ((flags & PMF_CACHE_MAINT) != 0U)
+	if ((flags & PMF_CACHE_MAINT) != 0U) {
+#if PMF_RING_DEPTH
+		/* The owner may not have cleaned it: do not drop its update */
+		flush_dcache_range((uintptr_t)ts_addr,
+				   sizeof(unsigned long long));
+#else
 		inv_dcache_range((uintptr_t)ts_addr, sizeof(unsigned long long));
+#endif
+	}
 
 	return *ts_addr;
 }
+
+/*
+ * This function cleans the timestamps of the current cpu to memory. In ring
+ * mode, captures are plain stores: the PSCI power down sequence calls this
+ * instead of each capture doing its own cache maintenance.
+ */
+void pmf_flush_my_timestamps(void)
+{
+	flush_dcache_range(PMF_TIMESTAMP_ARRAY_START +
+			   (plat_my_core_pos() * PMF_PERCPU_TIMESTAMP_SIZE),
+			   PMF_PERCPU_TIMESTAMP_SIZE);
+}
+
+#if PMF_RING_DEPTH
+CASSERT(IS_POWER_OF_TWO(PMF_RING_DEPTH), assert_pmf_ring_depth_power_of_two);
+
+/*
+ * This function calculates the address of the ring identified by
+ * `ring_base`, `tid` and `cpuid`.
+ */
+static inline pmf_ring_t *calc_ring_addr(uintptr_t ring_base,
+		unsigned int tid,
+		unsigned int cpuid)
+{
+	assert(cpuid < PLATFORM_CORE_COUNT);
+	assert(ring_base >= PMF_TIMESTAMP_ARRAY_START);
+	assert(ring_base < ((PMF_TIMESTAMP_ARRAY_START +
+		PMF_PERCPU_TIMESTAMP_SIZE) - ((tid & PMF_TID_MASK) *
+		sizeof(pmf_ring_t))));
+
+	return (pmf_ring_t *)(ring_base + (cpuid * PMF_PERCPU_TIMESTAMP_SIZE) +
+			      ((tid & PMF_TID_MASK) * sizeof(pmf_ring_t)));
+}
+
+/*
+ * This function appends the `ts` value to the ring identified by
+ * `ring_base`, `tid` and current cpu id. Only the owning CPU writes into it.
+ */
+void __pmf_store_ring_timestamp(uintptr_t ring_base,
+			unsigned int tid,
+			unsigned long long ts)
+{
+	pmf_ring_t *ring = calc_ring_addr(ring_base, tid, plat_my_core_pos());
+
+	ring->ts[ring->count & (PMF_RING_DEPTH - 1U)] = ts;
+	ring->count++;
+}
+
+/*
+ * This function retrieves a sample, or the sample count, from the ring
+ * identified by `ring_base`, `tid` and `cpuid`. With PMF_CACHE_MAINT, the
+ * ring is cleaned and invalidated first, so that a copy left in a cache
+ * is neither lost nor returned stale.
+ */
+unsigned long long __pmf_get_ring_timestamp(uintptr_t ring_base,
+			unsigned int tid,
+			unsigned int cpuid,
+			unsigned int flags)
+{
+	pmf_ring_t *ring = calc_ring_addr(ring_base, tid, cpuid);
+	unsigned long long count;
+	unsigned int sample;
+
+	if ((flags & PMF_CACHE_MAINT) != 0U)
+		flush_dcache_range((uintptr_t)ring, sizeof(pmf_ring_t));
+
+	count = ring->count;
+
+	if ((flags & PMF_RING_COUNT) != 0U)
+		return count;
+
+	sample = (flags & PMF_RING_SAMPLE_MASK) >> PMF_RING_SAMPLE_SHIFT;
+	if ((sample >= PMF_RING_DEPTH) || (sample >= count))
+		return 0ULL;
+
+	return ring->ts[(count - 1U - sample) & (PMF_RING_DEPTH - 1U)];
+}
+#endif /* PMF_RING_DEPTH */
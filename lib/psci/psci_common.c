@@ -14,6 +14,7 @@
 #include <context.h>
 #include <drivers/delay_timer.h>
 #include <lib/el3_runtime/context_mgmt.h>
+#include <lib/pmf/pmf.h>
 #include <lib/utils.h>
 #include <plat/common/platform.h>
 
@@ -956,6 +957,11 @@ int psci_secondaries_brought_up(void)
  ******************************************************************************/
 void psci_do_pwrdown_sequence(unsigned int power_level)
 {
+#if ENABLE_PMF && PMF_RING_DEPTH
+	/* Timestamps captured without cache maintenance */
+	pmf_flush_my_timestamps();
+#endif
+
 #if HW_ASSISTED_COHERENCY
 	/*
 	 * With hardware-assisted coherency, the CPU drivers only initiate the
@@ -9,6 +9,7 @@
 #include <string.h>
 
 #include <common/debug.h>
+#include <lib/checksum.h>
 #include <lib/utils.h>
 #include <tf_gunzip.h>
 
@@ -19,6 +20,8 @@
  */
 #define ZALLOC_ALIGNMENT	sizeof(void *)
 
+#define GZIP_TRAILER_SIZE	8U
+
 static uintptr_t zalloc_start;
 static uintptr_t zalloc_end;
 static uintptr_t zalloc_current;
@@ -47,6 +50,37 @@ static void ZLIB_INTERNAL zfree(void *opaque, void *ptr)
 {
 }
 
+/*
+ * The gzip trailer, made of the CRC32 and the size of the uncompressed data,
+ * is checked here with the checksum service instead of the zlib byte loop.
+ */
+static int gunzip_check_trailer(z_stream *stream, uintptr_t out_start)
+{
+	const uint8_t *trailer = stream->next_in - GZIP_TRAILER_SIZE;
+	uint32_t crc, isize;
+
+	if (stream->total_in < GZIP_TRAILER_SIZE)
+		return -EIO;
+
+	crc = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) |
+	      ((uint32_t)trailer[3] << 24);
+	isize = trailer[4] | (trailer[5] << 8) | (trailer[6] << 16) |
+		((uint32_t)trailer[7] << 24);
+
+	if (isize != (uint32_t)stream->total_out) {
+		ERROR("zlib: incorrect length check\n");
+		return -EIO;
+	}
+
+	if (checksum_crc32(0U, (const void *)out_start, stream->total_out) !=
+	    crc) {
+		ERROR("zlib: incorrect data check\n");
+		return -EIO;
+	}
+
+	return 0;
+}
+
 /*
  * gunzip - decompress gzip data
  * @in_buf: source of compressed input. Upon exit, the end of input.
@@ -80,9 +114,17 @@ int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
 		return (zret == Z_MEM_ERROR) ? -ENOMEM : -EIO;
 	}
 
+	/* The CRC32 is computed by gunzip_check_trailer() */
+	zret = inflateValidate(&stream, 0);
+	if (zret != Z_OK) {
+		ERROR("zlib: inflate validate failed (ret = %d)\n", zret);
+		inflateEnd(&stream);
+		return -EIO;
+	}
+
 	zret = inflate(&stream, Z_NO_FLUSH);
 	if (zret == Z_STREAM_END) {
-		ret = 0;
+		ret = gunzip_check_trailer(&stream, *out_buf);
 	} else {
 		if (stream.msg)
 			ERROR("%s\n", stream.msg);
@@ -19,6 +19,9 @@ ZLIB_SOURCES	:=	$(addprefix $(ZLIB_PATH)/,	\
 ZLIB_SOURCES	+=	$(addprefix $(ZLIB_PATH)/,	\
 					tf_gunzip.c)
 
+# tf_gunzip.c also needs $(CHECKSUM_SOURCES), from lib/checksum/checksum.mk,
+# which the platform adds to its sources once.
+
 INCLUDES	+=	-Iinclude/lib/zlib
 
 # REVISIT: the following flags need not be given globally
@@ -36,6 +36,9 @@ BL2_IN_XIP_MEM			:= 0
 # Do dcache invalidate upon BL2 entry at EL3
 BL2_INV_DCACHE			:= 1
 
+# Authenticate the certificates of the images loaded by BL2 in storage order
+BL2_STORAGE_ORDER_LOAD		:= 0
+
 # Select the branch protection features to use.
 BRANCH_PROTECTION		:= 0
 
@@ -92,6 +95,10 @@ ENABLE_PIE			:= 0
 # Flag to enable Performance Measurement Framework
 ENABLE_PMF			:= 0
 
+# Number of captures kept per PMF timestamp and CPU, 0 to keep only the
+# latest one
+PMF_RING_DEPTH			:= 0
+
 # Flag to enable PSCI STATs functionality
 ENABLE_PSCI_STAT		:= 0
 
@@ -180,6 +187,13 @@ MEASURED_BOOT			:= 0
 # NS timer register save and restore
 NS_TIMER_SWITCH			:= 0
 
+# Size of the BL33 chunks authenticated separately (0: BL33 is hashed as a
+# whole)
+NT_FW_HASH_CHUNK_SIZE		:= 0
+
+# Let OP-TEE load its pageable part from storage instead of BL2
+OPTEE_DEFER_PAGED_LOAD		:= 0
+
 # Include lib/libc in the final image
 OVERRIDE_LIBC			:= 0
 
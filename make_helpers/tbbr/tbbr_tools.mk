@@ -101,6 +101,9 @@ ifneq (${BL33},)
 ifneq (${COT},dualroot)
     $(eval $(call TOOL_ADD_PAYLOAD,${BUILD_PLAT}/nt_fw_key.crt,--nt-fw-key-cert))
 endif
+ifneq (${NT_FW_HASH_CHUNK_SIZE},0)
+    $(eval $(call CERT_ADD_CMD_OPT,${NT_FW_HASH_CHUNK_SIZE},--nt-fw-chunk-size))
+endif
 endif
 
 # Add SiP owned Secure Partitions CoT (image cert)
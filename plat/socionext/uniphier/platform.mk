@@ -119,9 +119,11 @@ endif
 ifeq (${FIP_GZIP},1)
 
 include lib/zlib/zlib.mk
+include lib/checksum/checksum.mk
 
 BL2_SOURCES		+=	common/image_decompress.c		\
-				$(ZLIB_SOURCES)
+				$(ZLIB_SOURCES)				\
+				$(CHECKSUM_SOURCES)
 
 $(eval $(call add_define,UNIPHIER_DECOMPRESS_GZIP))
 
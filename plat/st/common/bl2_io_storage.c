@@ -513,3 +513,51 @@ int plat_try_next_boot_source(unsigned int image_id)
 
 	return 1;
 }
+
+#if OPTEE_DEFER_PAGED_LOAD
+/*
+ * Return the boot interface and instance, as stored in the boot context, as
+ * storage identifier, and the offset of an image of the FIP on the boot device.
+ * On NAND, the offset does not account for bad blocks.
+ */
+int plat_get_image_storage_location(unsigned int image_id,
+				    uint32_t *storage_id, uint64_t *offset)
+{
+	boot_api_context_t *boot_context =
+		(boot_api_context_t *)stm32mp_get_boot_ctx_address();
+	uint16_t boot_itf = stm32mp_get_boot_itf_selected();
+	uintptr_t dev_handle;
+	uintptr_t image_spec;
+	uintptr_t image_handle;
+	size_t fip_offset;
+	int rc;
+
+	if ((boot_itf == BOOT_API_CTX_BOOT_INTERFACE_SEL_SERIAL_UART) ||
+	    (boot_itf == BOOT_API_CTX_BOOT_INTERFACE_SEL_SERIAL_USB)) {
+		return -ENOTSUP;
+	}
+
+	rc = plat_get_image_source(image_id, &dev_handle, &image_spec);
+	if (rc != 0) {
+		return rc;
+	}
+
+	rc = io_open(dev_handle, image_spec, &image_handle);
+	if (rc == 0) {
+		rc = fip_file_get_offset(image_handle, &fip_offset);
+		(void)io_close(image_handle);
+	}
+
+	(void)io_dev_close(dev_handle);
+
+	if (rc != 0) {
+		return rc;
+	}
+
+	*storage_id = ((uint32_t)boot_itf << 16) |
+		      boot_context->boot_interface_instance;
+	*offset = (uint64_t)image_block_spec.offset + fip_offset;
+
+	return 0;
+}
+#endif /* OPTEE_DEFER_PAGED_LOAD */
@@ -43,6 +43,25 @@ static gicv2_driver_data_t platform_gic_data = {
 
 static struct stm32_gic_instance stm32_gic;
 
+/*
+ * Register images of the SPI configuration, holding the secure SPIs from the
+ * platform interrupt properties and from the device tree.
+ */
+static uint32_t spi_igroupr[GICV2_SPI_CFG_WORDS(STM32MP_GIC_SPI_NUM)];
+static uint32_t spi_isenabler[GICV2_SPI_CFG_WORDS(STM32MP_GIC_SPI_NUM)];
+static uint32_t spi_icfgr[GICV2_SPI_CFG_ICFGR_WORDS(STM32MP_GIC_SPI_NUM)];
+static uint8_t spi_ipriorityr[STM32MP_GIC_SPI_NUM];
+static uint8_t spi_itargetsr[STM32MP_GIC_SPI_NUM];
+
+static gicv2_spi_cfg_t stm32_spi_cfg = {
+	.num_spis = STM32MP_GIC_SPI_NUM,
+	.igroupr = spi_igroupr,
+	.isenabler = spi_isenabler,
+	.icfgr = spi_icfgr,
+	.ipriorityr = spi_ipriorityr,
+	.itargetsr = spi_itargetsr,
+};
+
 static uint32_t enable_gic_interrupt(const fdt32_t *array)
 {
 	unsigned int id, cfg;
@@ -67,6 +86,14 @@ static uint32_t enable_gic_interrupt(const fdt32_t *array)
 
 	if ((id >= MIN_SPI_ID) && (id <= MAX_SPI_ID)) {
 		VERBOSE("Enable IT %i\n", id);
+
+		if (gicv2_spi_cfg_set_secure(&stm32_spi_cfg, id,
+				STM32MP_IRQ_SEC_SPI_PRIO, cfg,
+				target_mask_array[STM32MP_PRIMARY_CPU]) == 0) {
+			gicv2_spi_cfg_apply_one(&stm32_spi_cfg, id);
+			return id;
+		}
+
 		gicv2_set_interrupt_type(id, GICV2_INTR_GROUP0);
 		gicv2_set_interrupt_priority(id, STM32MP_IRQ_SEC_SPI_PRIO);
 		gicv2_set_spi_routing(id, STM32MP_PRIMARY_CPU);
@@ -140,7 +167,13 @@ void stm32_gic_init(void)
 	}
 
 	gicv2_driver_init(&platform_gic_data);
-	gicv2_distif_init();
+
+	/*
+	 * Secure SPIs enabled from the device tree are added to the images
+	 * later on, see stm32_gic_enable_spi().
+	 */
+	gicv2_spi_cfg_init(&stm32_spi_cfg);
+	gicv2_distif_init_spi_cfg(&stm32_spi_cfg);
 
 	stm32_gic_pcpu_init();
 }
@@ -16,6 +16,7 @@
 #include <drivers/st/stm32_iwdg.h>
 #include <drivers/st/stm32_uart.h>
 #include <drivers/st/stm32_uart_regs.h>
+#include <lib/checksum.h>
 #include <lib/mmio.h>
 #include <tools_share/firmware_image_package.h>
 
@@ -324,9 +325,10 @@ static int uart_download_part(void)
 		}
 
 		*(handle.addr + i) = byte;
-		xor ^= byte;
 	}
 
+	xor = checksum_xor8(xor, handle.addr, packet_size);
+
 	/* Checksum */
 	ret = uart_read_8(&byte) != 0;
 	if (ret != 0) {
@@ -13,6 +13,7 @@
 #include <common/debug.h>
 #include <drivers/st/stm32mp_clkfunc.h>
 #include <drivers/st/stm32mp_pmic.h>
+#include <lib/checksum.h>
 #include <lib/spinlock.h>
 #include <lib/utils.h>
 #include <lib/xlat_tables/xlat_tables_v2.h>
@@ -129,12 +130,10 @@ int stm32mp_check_header(boot_api_image_header_t *header, uintptr_t buffer)
 	}
 
 	if (header->option_flags == 1U) {
-		uint32_t i;
-		uint32_t img_checksum = 0U;
+		uint32_t img_checksum;
 
-		for (i = 0U; i < header->image_length; i++) {
-			img_checksum += *(uint8_t *)(buffer + i);
-		}
+		img_checksum = checksum_add8(0U, (const void *)buffer,
+					     header->image_length);
 
 		if (header->payload_checksum != img_checksum) {
 			ERROR("Checksum: 0x%x (awaited: 0x%x)\n", img_checksum,
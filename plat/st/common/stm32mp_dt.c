@@ -287,6 +287,43 @@ uint32_t dt_get_ddr_size(void)
 	return size;
 }
 
+/*******************************************************************************
+ * This function gets the DDR controller QoS profiles from the DT: cells are
+ * filled with the st,ctl-perf-profiles values, up to max_cells.
+ * Returns the number of cells read on success and a negative FDT error code
+ * on failure.
+ ******************************************************************************/
+int dt_get_ddr_qos_profiles(uint32_t *cells, unsigned int max_cells)
+{
+	const fdt32_t *cuint;
+	unsigned int i;
+	int node;
+	int len;
+
+	assert(cells != NULL);
+
+	node = fdt_node_offset_by_compatible(fdt, -1, DT_DDR_COMPAT);
+	if (node < 0) {
+		return -FDT_ERR_NOTFOUND;
+	}
+
+	cuint = fdt_getprop(fdt, node, "st,ctl-perf-profiles", &len);
+	if (cuint == NULL) {
+		return -FDT_ERR_NOTFOUND;
+	}
+
+	len /= (int)sizeof(uint32_t);
+	if ((unsigned int)len > max_cells) {
+		return -FDT_ERR_BADVALUE;
+	}
+
+	for (i = 0U; i < (unsigned int)len; i++) {
+		cells[i] = fdt32_to_cpu(cuint[i]);
+	}
+
+	return len;
+}
+
 /*******************************************************************************
  * This function gets OPP table node from the DT.
  * Returns node offset on success and a negative FDT error code on failure.
@@ -16,10 +16,12 @@
 #include <common/desc_image_load.h>
 #include <drivers/clk.h>
 #include <drivers/delay_timer.h>
+#include <drivers/dma.h>
 #include <drivers/generic_delay_timer.h>
 #include <drivers/st/bsec.h>
 #include <drivers/st/stm32_console.h>
 #include <drivers/st/stm32_iwdg.h>
+#include <drivers/st/stm32_mdma.h>
 #include <drivers/st/stm32_uart.h>
 #include <drivers/st/stm32mp_clkfunc.h>
 #include <drivers/st/stm32mp_pmic.h>
@@ -41,6 +43,7 @@
 #include <stm32mp1_dbgmcu.h>
 
 #define RESET_TIMEOUT_US_1MS		1000U
+#define MDMA_BENCHMARK_SIZE		U(0x00400000)
 
 static const char debug_msg[626] = {
 	"***************************************************\n"
@@ -62,7 +65,7 @@ static enum boot_device_e boot_device = BOOT_DEVICE_BOARD;
 
 static void print_reset_reason(void)
 {
-	uint32_t rstsr = mmio_read_32(stm32mp_rcc_base() + RCC_MP_RSTSCLRR);
+	uint32_t rstsr = stm32mp1_get_reset_status();
 
 	if (rstsr == 0U) {
 		WARN("Reset reason unknown\n");
@@ -202,6 +205,14 @@ void bl2_platform_setup(void)
 		ERROR("DDR mapping: error %d\n", ret);
 		panic();
 	}
+
+#if STM32MP_MDMA_BENCHMARK
+	/* The end of DDR is not loaded yet, unless kept across standby */
+	if (!stm32mp1_ddr_is_restored()) {
+		dma_benchmark(STM32MP_DDR_BASE + dt_get_ddr_size() -
+			      MDMA_BENCHMARK_SIZE, MDMA_BENCHMARK_SIZE);
+	}
+#endif
 }
 
 static void update_monotonic_counter(void)
@@ -474,6 +485,12 @@ skip_console_init:
 
 	stm32mp1_syscfg_init();
 
+#if STM32MP_MDMA
+	if (stm32_mdma_init(STM32MP_MDMA_BL2_CHANNELS) != 0) {
+		WARN("MDMA unavailable, copies done by the CPU\n");
+	}
+#endif
+
 	if (stm32_iwdg_init() < 0) {
 		panic();
 	}
@@ -608,6 +625,24 @@ int bl2_plat_handle_post_image_load(unsigned int image_id)
 				bl_mem_params->image_info.h.attr &= ~IMAGE_ATTRIB_SKIP_LOADING;
 			}
 
+#if STM32MP_WARM_BOOT
+			/*
+			 * After a warm reset, BL33 and HW_CONFIG left in DDR
+			 * are not reloaded if they still match the chain of
+			 * trust. Their post-load handling does not depend on
+			 * their content.
+			 */
+			if (!wakeup_ddr_sr && stm32mp1_is_warm_reset() &&
+			    ((image_ids[i] == BL33_IMAGE_ID) ||
+			     (image_ids[i] == HW_CONFIG_ID)) &&
+			    (auth_image_in_place(image_ids[i],
+						 &bl_mem_params->image_info) == 0)) {
+				INFO("BL2: Image id %u kept from previous boot\n",
+				     image_ids[i]);
+				bl_mem_params->image_info.h.attr |= IMAGE_ATTRIB_SKIP_LOADING;
+			}
+#endif
+
 			switch (image_ids[i]) {
 			case BL32_IMAGE_ID:
 				bl_mem_params->ep_info.pc = config_info->config_addr;
@@ -635,6 +670,13 @@ int bl2_plat_handle_post_image_load(unsigned int image_id)
 				} else {
 					bl_mem_params->ep_info.pc = config_info->config_addr;
 				}
+
+#if STM32MP_WARM_BOOT
+				/* Also set here as the post-load handling may be skipped */
+				bl32_mem_params = get_bl_mem_params_node(BL32_IMAGE_ID);
+				assert(bl32_mem_params != NULL);
+				bl32_mem_params->ep_info.lr_svc = bl_mem_params->ep_info.pc;
+#endif
 				break;
 
 			case HW_CONFIG_ID:
@@ -685,6 +727,34 @@ int bl2_plat_handle_post_image_load(unsigned int image_id)
 			bl_mem_params->ep_info.args.arg0 = paged_mem_params->image_info.image_base;
 			bl_mem_params->ep_info.args.arg1 = 0; /* Unused */
 			bl_mem_params->ep_info.args.arg2 = 0; /* No DT supported */
+
+#if OPTEE_DEFER_PAGED_LOAD
+			/*
+			 * The descriptor of the pageable part is put where it
+			 * is to be loaded: OP-TEE reads it before loading it.
+			 * The pageable part is never loaded by BL2, so one too
+			 * small to hold it cannot be booted.
+			 */
+			if (paged_mem_params->image_info.image_size != 0U) {
+				optee_paged_desc_t *desc = (optee_paged_desc_t *)
+					paged_mem_params->image_info.image_base;
+
+				if (paged_mem_params->image_info.image_size <
+				    sizeof(optee_paged_desc_t)) {
+					ERROR("OPTEE pageable part too small\n");
+					panic();
+				}
+
+				err = optee_defer_paged_image(BL32_EXTRA2_IMAGE_ID,
+							      &paged_mem_params->image_info,
+							      desc);
+				if (err != 0) {
+					panic();
+				}
+
+				bl_mem_params->ep_info.args.arg1 = (uintptr_t)desc;
+			}
+#endif
 		} else {
 #if STM32MP_USE_STM32IMAGE
 			bl_mem_params->ep_info.pc = STM32MP_BL32_BASE;
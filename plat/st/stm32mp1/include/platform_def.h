@@ -56,6 +56,10 @@
 #define MAX_IO_HANDLES			U(4)
 #define MAX_IO_BLOCK_DEVICES		U(1)
 #define MAX_IO_MTD_DEVICES		U(1)
+#define PLAT_FIP_TOC_CACHE_ENTRIES	U(16)
+
+/* BL2 loads images on a single CPU: flush images above 1MB by set/way */
+#define PLAT_IMAGE_DCACHE_SW_THRESHOLD	U(0x100000)
 
 /*******************************************************************************
  * BL2 specific defines.
@@ -158,6 +162,9 @@
 #define STM32MP1_IRQ_TAMPSERRS		U(229)
 #define STM32MP1_IRQ_AXIERRIRQ		U(244)
 
+/* Number of SPIs handled by the GIC, as a multiple of 32 */
+#define STM32MP_GIC_SPI_NUM		U(256)
+
 /*
  * Define a list of Group 1 Secure and Group 0 interrupts as per GICv3
  * terminology. On a GICv2 system or mode, the lists will be merged and treated
@@ -28,6 +28,8 @@ enum boot_device_e get_boot_device(void);
 
 bool stm32mp1_addr_inside_backupsram(uintptr_t addr);
 bool stm32mp1_is_wakeup_from_standby(void);
+uint32_t stm32mp1_get_reset_status(void);
+bool stm32mp1_is_warm_reset(void);
 
 int stm32_save_boot_interface(uint32_t interface, uint32_t instance);
 int stm32_get_boot_interface(uint32_t *interface, uint32_t *instance);
@@ -93,6 +93,32 @@
  */
 #define STM32_SMC_AUTO_STOP		0x8200100a
 
+/*
+ * SIP function STM32_SMC_DDR_QOS - DDR controller QoS profiles and DDRPERFM
+ * counters.
+ *
+ * Argument a0: (input) SMCC ID.
+ *		(output) Status return code.
+ * Argument a1: (input) Service ID (STM32_SMC_DDR_xxx).
+ *		(output) Profile count, profile or counter value, if applicable.
+ * Argument a2: (input) Profile or counter index, if applicable.
+ */
+#define STM32_SMC_DDR_QOS		0x8200100b
+
+/*
+ * SIP function STM32_SMC_PMU_STATS - SP_min PMU counters per SMC function ID,
+ * available when built with SP_MIN_PMU_STATS=1.
+ *
+ * Argument a0: (input) SMCC ID.
+ *		(output) Status return code.
+ * Argument a1: (input) Service ID (STM32_SMC_PMU_STATS_xxx).
+ *		(output) Entry count or field value low word, if applicable.
+ * Argument a2: (input) Entry index, if applicable.
+ *		(output) Field value high word, if applicable.
+ * Argument a3: (input) Field (STM32_SMC_PMU_xxx), if applicable.
+ */
+#define STM32_SMC_PMU_STATS		0x8200100c
+
 /*
  * STM32_SIP_SMC_SCMI_AGENT0
  * STM32_SIP_SMC_SCMI_AGENT1
@@ -114,7 +140,11 @@
 #define STM32_SIP_SVC_VERSION_MINOR	0x1
 
 /* Number of STM32 SiP Calls implemented */
-#define STM32_COMMON_SIP_NUM_CALLS	9
+#if SP_MIN_PMU_STATS
+#define STM32_COMMON_SIP_NUM_CALLS	11
+#else
+#define STM32_COMMON_SIP_NUM_CALLS	10
+#endif
 
 /* Service ID for STM32_SMC_RCC/_PWR */
 #define STM32_SMC_REG_READ		0x0
@@ -141,4 +171,27 @@
 #define STM32_SMC_RCC_OPP_SET		0x0
 #define STM32_SMC_RCC_OPP_ROUND		0x1
 
+/* Service ID for STM32_SMC_DDR_QOS */
+#define STM32_SMC_DDR_QOS_GET_NB	0x0
+#define STM32_SMC_DDR_QOS_GET		0x1
+#define STM32_SMC_DDR_QOS_SET		0x2
+#define STM32_SMC_DDR_PERF_START	0x3
+#define STM32_SMC_DDR_PERF_STOP		0x4
+#define STM32_SMC_DDR_PERF_READ		0x5
+
+/* Service ID for STM32_SMC_PMU_STATS */
+#define STM32_SMC_PMU_STATS_START	0x0
+#define STM32_SMC_PMU_STATS_STOP	0x1
+#define STM32_SMC_PMU_STATS_GET_NB	0x2
+#define STM32_SMC_PMU_STATS_READ	0x3
+
+/* Fields of an STM32_SMC_PMU_STATS entry */
+#define STM32_SMC_PMU_FID		0x0
+#define STM32_SMC_PMU_CALLS		0x1
+#define STM32_SMC_PMU_CYCLES		0x2
+#define STM32_SMC_PMU_INSTRUCTIONS	0x3
+#define STM32_SMC_PMU_L1D_REFILLS	0x4
+#define STM32_SMC_PMU_L2D_REFILLS	0x5
+#define STM32_SMC_PMU_L1D_TLB_REFILLS	0x6
+
 #endif /* STM32MP1_SMC_H */
@@ -24,6 +24,11 @@ VERSION_STRING		:=	v${VERSION_MAJOR}.${VERSION_MINOR}-${ST_VERSION}(${BUILD_TYPE
 ifneq ($(STM32MP_USE_STM32IMAGE),1)
 ENABLE_PIE		:=	1
 endif
+
+# The location of the OP-TEE pageable part is only known in a FIP
+ifeq ($(STM32MP_USE_STM32IMAGE)-$(OPTEE_DEFER_PAGED_LOAD),1-1)
+$(error OPTEE_DEFER_PAGED_LOAD is not supported with STM32MP_USE_STM32IMAGE)
+endif
 TRUSTED_BOARD_BOOT	?=	0
 STM32MP_USE_EXTERNAL_HEAP ?=	0
 
@@ -50,6 +55,30 @@ STM32_HEADER_VERSION_MINOR:=	0
 # STM32 Secure Secret Provisioning mode (SSP)
 STM32MP_SSP		?=	0
 
+# Park a CPU turned off by CPU_OFF in SP_MIN rather than resetting it
+STM32MP_PARK_OFF_CPU	?=	0
+
+# Offload large memory copies to the MDMA
+STM32MP_MDMA		?=	0
+# Print the MDMA throughput against the CPU copy at BL2 boot (debug only)
+STM32MP_MDMA_BENCHMARK	?=	0
+ifeq (${STM32MP_MDMA_BENCHMARK},1)
+ifneq (${STM32MP_MDMA},1)
+$(error STM32MP_MDMA_BENCHMARK requires STM32MP_MDMA=1)
+endif
+endif
+
+# Check the images left in DDR after a warm reset instead of reloading them
+STM32MP_WARM_BOOT	?=	0
+ifeq (${STM32MP_WARM_BOOT},1)
+ifeq (${STM32MP_USE_STM32IMAGE},1)
+$(error STM32MP_WARM_BOOT is not supported with STM32MP_USE_STM32IMAGE)
+endif
+ifneq (${TRUSTED_BOARD_BOOT},1)
+$(error STM32MP_WARM_BOOT requires TRUSTED_BOARD_BOOT to authenticate the images left in DDR)
+endif
+endif
+
 ifeq ($(AARCH32_SP),sp_min)
 # Disable Neon support: sp_min runtime may conflict with non-secure world
 TF_CFLAGS		+=	-mfloat-abi=soft
@@ -172,7 +201,11 @@ $(eval $(call assert_booleans,\
 		STM32MP_USB_PROGRAMMER \
 		STM32MP_USE_STM32IMAGE \
 		STM32MP_DDR_DUAL_AXI_PORT \
+		STM32MP_MDMA \
+		STM32MP_MDMA_BENCHMARK \
+		STM32MP_PARK_OFF_CPU \
 		STM32MP_SSP \
+		STM32MP_WARM_BOOT \
 		BL33_HYP \
 )))
 
@@ -198,7 +231,11 @@ $(eval $(call add_defines,\
 		STM32_TF_VERSION \
 		STM32MP_USE_STM32IMAGE \
 		STM32MP_DDR_DUAL_AXI_PORT \
+		STM32MP_MDMA \
+		STM32MP_MDMA_BENCHMARK \
+		STM32MP_PARK_OFF_CPU \
 		STM32MP_SSP \
+		STM32MP_WARM_BOOT \
 		BL33_HYP \
 )))
 
@@ -221,6 +258,9 @@ endif
 include lib/xlat_tables_v2/xlat_tables.mk
 PLAT_BL_COMMON_SOURCES	+=	${XLAT_TABLES_LIB_SRCS}
 
+include lib/checksum/checksum.mk
+PLAT_BL_COMMON_SOURCES	+=	${CHECKSUM_SOURCES}
+
 PLAT_BL_COMMON_SOURCES	+=	lib/cpus/aarch32/cortex_a7.S
 
 PLAT_BL_COMMON_SOURCES	+=	drivers/arm/tzc/tzc400.c				\
@@ -246,6 +286,11 @@ PLAT_BL_COMMON_SOURCES	+=	drivers/arm/tzc/tzc400.c				\
 				plat/st/stm32mp1/stm32mp1_helper.S			\
 				plat/st/stm32mp1/stm32mp1_syscfg.c
 
+ifeq (${STM32MP_MDMA},1)
+BL2_SOURCES		+=	drivers/dma/dma.c					\
+				drivers/st/dma/stm32_mdma.c
+endif
+
 ifneq (${STM32MP_USE_STM32IMAGE},1)
 BL2_SOURCES		+=	drivers/io/io_fip.c					\
 				plat/st/common/bl2_io_storage.c				\
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+
+#include <platform_def.h>
+
+#include <common/debug.h>
+#include <drivers/st/stm32mp1_ddr_helpers.h>
+
+#include <stm32mp1_smc.h>
+
+#include "ddr_svc.h"
+
+uint32_t ddr_qos_scv_handler(uint32_t x1, uint32_t x2, uint32_t *res)
+{
+	uint32_t cmd = x1;
+	int ret;
+
+	switch (cmd) {
+	case STM32_SMC_DDR_QOS_GET_NB:
+		*res = ddr_qos_get_profile_nb();
+		break;
+
+	case STM32_SMC_DDR_QOS_GET:
+		*res = ddr_qos_get_profile();
+		break;
+
+	case STM32_SMC_DDR_QOS_SET:
+		ret = ddr_qos_set_profile(x2);
+		if (ret == -EINVAL) {
+			return STM32_SMC_INVALID_PARAMS;
+		}
+
+		if (ret == -ENOTSUP) {
+			return STM32_SMC_NOT_SUPPORTED;
+		}
+
+		if (ret != 0) {
+			return STM32_SMC_FAILED;
+		}
+		break;
+
+	case STM32_SMC_DDR_PERF_START:
+		ddr_perf_start();
+		break;
+
+	case STM32_SMC_DDR_PERF_STOP:
+		ddr_perf_stop();
+		break;
+
+	case STM32_SMC_DDR_PERF_READ:
+		ret = ddr_perf_read(x2, res);
+		if (ret == -EINVAL) {
+			return STM32_SMC_INVALID_PARAMS;
+		}
+
+		if (ret != 0) {
+			return STM32_SMC_FAILED;
+		}
+		break;
+
+	default:
+		return STM32_SMC_INVALID_PARAMS;
+	}
+
+	return STM32_SMC_OK;
+}
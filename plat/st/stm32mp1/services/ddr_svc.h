@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2020, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef DDR_SVC_H
+#define DDR_SVC_H
+
+uint32_t ddr_qos_scv_handler(uint32_t x1, uint32_t x2, uint32_t *res);
+
+#endif /* DDR_SVC_H */
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+
+#include <sp_min_pmu.h>
+
+#include <stm32mp1_smc.h>
+
+#include "pmu_svc.h"
+
+static int pmu_stats_field(const struct sp_min_pmu_stats *stats,
+			   uint32_t field, uint64_t *value)
+{
+	switch (field) {
+	case STM32_SMC_PMU_FID:
+		*value = stats->smc_fid;
+		break;
+	case STM32_SMC_PMU_CALLS:
+		*value = stats->calls;
+		break;
+	case STM32_SMC_PMU_CYCLES:
+		*value = stats->counter[SP_MIN_PMU_CYCLES];
+		break;
+	case STM32_SMC_PMU_INSTRUCTIONS:
+		*value = stats->counter[SP_MIN_PMU_INSTRUCTIONS];
+		break;
+	case STM32_SMC_PMU_L1D_REFILLS:
+		*value = stats->counter[SP_MIN_PMU_L1D_REFILLS];
+		break;
+	case STM32_SMC_PMU_L2D_REFILLS:
+		*value = stats->counter[SP_MIN_PMU_L2D_REFILLS];
+		break;
+	case STM32_SMC_PMU_L1D_TLB_REFILLS:
+		*value = stats->counter[SP_MIN_PMU_L1D_TLB_REFILLS];
+		break;
+	default:
+		return -1;
+	}
+
+	return 0;
+}
+
+uint32_t pmu_stats_scv_handler(uint32_t x1, uint32_t x2, uint32_t x3,
+			       uint32_t *res_lo, uint32_t *res_hi)
+{
+	struct sp_min_pmu_stats stats;
+	uint64_t value;
+
+	switch (x1) {
+	case STM32_SMC_PMU_STATS_START:
+		sp_min_pmu_stats_start();
+		break;
+
+	case STM32_SMC_PMU_STATS_STOP:
+		sp_min_pmu_stats_stop();
+		break;
+
+	case STM32_SMC_PMU_STATS_GET_NB:
+		*res_lo = sp_min_pmu_stats_count();
+		break;
+
+	case STM32_SMC_PMU_STATS_READ:
+		if ((sp_min_pmu_stats_read(x2, &stats) != 0) ||
+		    (pmu_stats_field(&stats, x3, &value) != 0)) {
+			return STM32_SMC_INVALID_PARAMS;
+		}
+
+		*res_lo = (uint32_t)value;
+		*res_hi = (uint32_t)(value >> 32);
+		break;
+
+	default:
+		return STM32_SMC_INVALID_PARAMS;
+	}
+
+	return STM32_SMC_OK;
+}
@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PMU_SVC_H
+#define PMU_SVC_H
+
+uint32_t pmu_stats_scv_handler(uint32_t x1, uint32_t x2, uint32_t x3,
+			       uint32_t *res_lo, uint32_t *res_hi);
+
+#endif /* PMU_SVC_H */
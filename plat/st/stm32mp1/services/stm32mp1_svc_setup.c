@@ -17,7 +17,11 @@
 #include <stm32mp1_smc.h>
 
 #include "bsec_svc.h"
+#include "ddr_svc.h"
 #include "low_power_svc.h"
+#if SP_MIN_PMU_STATS
+#include "pmu_svc.h"
+#endif
 #include "pwr_svc.h"
 #include "rcc_svc.h"
 
@@ -45,8 +49,8 @@ static uintptr_t stm32mp1_svc_smc_handler(uint32_t smc_fid, u_register_t x1,
 					  u_register_t x4, void *cookie,
 					  void *handle, u_register_t flags)
 {
-	uint32_t ret1 = 0U, ret2 = 0U;
-	bool ret_uid = false, ret2_enabled = false;
+	uint32_t ret1 = 0U, ret2 = 0U, ret3 = 0U;
+	bool ret_uid = false, ret2_enabled = false, ret3_enabled = false;
 
 	switch (smc_fid) {
 	case STM32_SIP_SVC_CALL_COUNT:
@@ -96,6 +100,18 @@ static uintptr_t stm32mp1_svc_smc_handler(uint32_t smc_fid, u_register_t x1,
 		ret1 = STM32_SMC_OK;
 		break;
 
+	case STM32_SMC_DDR_QOS:
+		ret1 = ddr_qos_scv_handler(x1, x2, &ret2);
+		ret2_enabled = true;
+		break;
+
+#if SP_MIN_PMU_STATS
+	case STM32_SMC_PMU_STATS:
+		ret1 = pmu_stats_scv_handler(x1, x2, x3, &ret2, &ret3);
+		ret3_enabled = true;
+		break;
+#endif
+
 	case STM32_SIP_SMC_SCMI_AGENT0:
 		scmi_smt_fastcall_smc_entry(0);
 		break;
@@ -113,6 +129,10 @@ static uintptr_t stm32mp1_svc_smc_handler(uint32_t smc_fid, u_register_t x1,
 		SMC_UUID_RET(handle, stm32_sip_svc_uid);
 	}
 
+	if (ret3_enabled) {
+		SMC_RET3(handle, ret1, ret2, ret3);
+	}
+
 	if (ret2_enabled) {
 		SMC_RET2(handle, ret1, ret2);
 	}
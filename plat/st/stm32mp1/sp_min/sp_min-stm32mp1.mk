@@ -51,12 +51,17 @@ BL32_SOURCES		+=	drivers/st/scmi-msg/base.c		\
 
 # stm32mp1 specific services
 BL32_SOURCES		+=	plat/st/stm32mp1/services/bsec_svc.c		\
+				plat/st/stm32mp1/services/ddr_svc.c		\
 				plat/st/stm32mp1/services/low_power_svc.c	\
 				plat/st/stm32mp1/services/pwr_svc.c		\
 				plat/st/stm32mp1/services/rcc_svc.c		\
 				plat/st/stm32mp1/services/stm32mp1_svc_setup.c	\
 				plat/st/stm32mp1/stm32mp1_scmi.c
 
+ifeq (${SP_MIN_PMU_STATS},1)
+BL32_SOURCES		+=	plat/st/stm32mp1/services/pmu_svc.c
+endif
+
 # Arm Archtecture services
 BL32_SOURCES		+=	services/arm_arch_svc/arm_arch_svc_setup.c
 
@@ -593,6 +593,10 @@ void sp_min_platform_setup(void)
 
 	ddr_save_sr_mode();
 
+	if (ddr_qos_init() != 0) {
+		WARN("DDR: only boot QoS settings available\n");
+	}
+
 	generic_delay_timer_init();
 
 	stm32_gic_init();
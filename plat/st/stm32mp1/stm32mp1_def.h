@@ -608,6 +608,11 @@ static inline uint32_t tamp_bkpr(uint32_t idx)
  ******************************************************************************/
 #define DDRPHYC_BASE			U(0x5A004000)
 
+/*******************************************************************************
+ * STM32MP1 DDRPERFM
+ ******************************************************************************/
+#define DDRPERFM_BASE			U(0x5A007000)
+
 /*******************************************************************************
  * STM32MP1 IWDG
  ******************************************************************************/
@@ -633,6 +638,14 @@ static inline uint32_t tamp_bkpr(uint32_t idx)
 #define STGEN_BASE			U(0x5c008000)
 #define SYSCFG_BASE			U(0x50020000)
 
+/*******************************************************************************
+ * STM32MP1 MDMA
+ ******************************************************************************/
+#define MDMA_BASE			U(0x58000000)
+
+/* Channels used by BL2 */
+#define STM32MP_MDMA_BL2_CHANNELS	U(0x0000000F)
+
 /*******************************************************************************
  * STM32MP1 TIMERS
  ******************************************************************************/
@@ -30,6 +30,112 @@ static uintptr_t stm32_sec_entrypoint;
 static uint32_t cntfrq_core0;
 static uintptr_t saved_entrypoint;
 
+#if STM32MP_PARK_OFF_CPU
+#define CPU_PARKED		U(0x5041524B) /* "PARK" */
+
+/*
+ * Mailbox of the secondary CPU parked by CPU_OFF. The parked CPU runs with its
+ * data cache disabled: the primary CPU cleans or invalidates the whole lines
+ * around its accesses.
+ */
+static struct cpu_park_s {
+	uint32_t state;
+	uintptr_t entrypoint;
+} __aligned(CACHE_WRITEBACK_GRANULE) cpu_park;
+
+/*
+ * Counter value at CPU_ON, read back by the secondary CPU once its data cache
+ * is enabled. Kept out of the mailbox line, which the primary CPU must not
+ * write through the cache while the parked CPU owns it.
+ */
+static unsigned long long cpu_on_count __aligned(CACHE_WRITEBACK_GRANULE);
+
+/*
+ * Called by the secondary CPU from CPU_OFF, before PSCI reports it off: a
+ * CPU_ON then always finds it parked, even while it is still on its way to
+ * the park loop, and never takes the ROM code path.
+ */
+static void stm32_prepare_park_cpu(void)
+{
+	volatile struct cpu_park_s *park = &cpu_park;
+
+	park->entrypoint = 0U;
+	park->state = CPU_PARKED;
+	dsb();
+}
+
+/*
+ * Park the secondary CPU in a WFI loop until CPU_ON provides its entry point,
+ * instead of resetting it: it then skips the ROM code. CPU_ON raises the
+ * secure SGI0 once the entry point is written, so that the SGI0 is consumed
+ * here even if the entry point was written before the loop was entered.
+ * Other secure interrupts are handled as in sp_min_fiq().
+ */
+static void __dead2 stm32_park_cpu(void)
+{
+	volatile struct cpu_park_s *park = &cpu_park;
+	void (*warm_entrypoint)(void);
+	uint32_t interrupt = GIC_SPURIOUS_INTERRUPT;
+
+	while ((interrupt != ARM_IRQ_SEC_SGI_0) || (park->entrypoint == 0U)) {
+		wfi();
+
+		interrupt = gicv2_acknowledge_interrupt();
+		if ((interrupt == PENDING_G1_INTID) ||
+		    (interrupt == GIC_SPURIOUS_INTERRUPT)) {
+			continue;
+		}
+
+		if (interrupt != ARM_IRQ_SEC_SGI_0) {
+			sp_min_plat_fiq_handler(interrupt);
+		}
+
+		gicv2_end_of_interrupt(interrupt);
+	}
+
+	warm_entrypoint = (void (*)(void))park->entrypoint;
+
+	/* The warm entry point expects the MMU off, as out of ROM code */
+	disable_mmu_icache_secure();
+
+	warm_entrypoint();
+
+	/* This shouldn't be reached */
+	panic();
+}
+
+/* Release the parked CPU, return false if it is not parked */
+static bool stm32_unpark_cpu(uintptr_t entrypoint)
+{
+	inv_dcache_range((uintptr_t)&cpu_park, sizeof(cpu_park));
+
+	if (cpu_park.state != CPU_PARKED) {
+		return false;
+	}
+
+	cpu_park.state = 0U;
+	cpu_park.entrypoint = entrypoint;
+	flush_dcache_range((uintptr_t)&cpu_park, sizeof(cpu_park));
+
+	if (entrypoint != 0U) {
+		gicv2_raise_sgi(ARM_IRQ_SEC_SGI_0, STM32MP_SECONDARY_CPU);
+	}
+
+	return true;
+}
+
+/* Reset the parked CPU, it then waits in ROM code as after a regular CPU_OFF */
+static void stm32_reset_parked_cpu(void)
+{
+	if (stm32mp_is_single_core() || !stm32_unpark_cpu(0U)) {
+		return;
+	}
+
+	mmio_write_32(stm32mp_rcc_base() + RCC_MP_GRSTCSETR,
+		      RCC_MP_GRSTCSETR_MPUP1RST);
+}
+#endif
+
 /*******************************************************************************
  * STM32MP1 handler called when a CPU is about to enter standby.
  * call by core 1 to enter in wfi
@@ -81,6 +187,16 @@ static int stm32_pwr_domain_on(u_register_t mpidr)
 		return PSCI_E_INVALID_PARAMS;
 	}
 
+#if STM32MP_PARK_OFF_CPU
+	cpu_on_count = read_cntpct_el0();
+	cntfrq_core0 = read_cntfrq_el0();
+
+	if ((stm32_sec_entrypoint == (uintptr_t)&sp_min_warm_entrypoint) &&
+	    stm32_unpark_cpu(stm32_sec_entrypoint)) {
+		return PSCI_E_SUCCESS;
+	}
+#endif
+
 	/* Reset backup register content */
 	mmio_write_32(bkpr_core1_magic, 0);
 
@@ -119,7 +235,11 @@ static int stm32_pwr_domain_on(u_register_t mpidr)
  ******************************************************************************/
 static void stm32_pwr_domain_off(const psci_power_state_t *target_state)
 {
-	/* Nothing to do */
+#if STM32MP_PARK_OFF_CPU
+	if (MPIDR_AFFLVL0_VAL(read_mpidr_el1()) != STM32MP_PRIMARY_CPU) {
+		stm32_prepare_park_cpu();
+	}
+#endif
 }
 
 /*******************************************************************************
@@ -130,6 +250,10 @@ static void stm32_pwr_domain_suspend(const psci_power_state_t *target_state)
 {
 	uint32_t soc_mode = stm32mp1_get_lp_soc_mode(PSCI_MODE_SYSTEM_SUSPEND);
 
+#if STM32MP_PARK_OFF_CPU
+	stm32_reset_parked_cpu();
+#endif
+
 	stm32_enter_low_power(soc_mode, saved_entrypoint);
 }
 
@@ -144,6 +268,12 @@ static void stm32_pwr_domain_on_finish(const psci_power_state_t *target_state)
 	stm32_gic_pcpu_init();
 
 	write_cntfrq_el0(cntfrq_core0);
+
+#if STM32MP_PARK_OFF_CPU
+	VERBOSE("CPU_ON latency: %u us\n",
+		(uint32_t)(read_cntpct_el0() - cpu_on_count) /
+		(cntfrq_core0 / 1000000U));
+#endif
 }
 
 /*******************************************************************************
@@ -178,6 +308,10 @@ static void __dead2 stm32_pwr_domain_pwr_down_wfi(const psci_power_state_t
 		warm_entrypoint();
 	}
 
+#if STM32MP_PARK_OFF_CPU
+	stm32_park_cpu();
+#endif
+
 	mmio_write_32(stm32mp_rcc_base() + RCC_MP_GRSTCSETR,
 		      RCC_MP_GRSTCSETR_MPUP1RST);
 
@@ -197,6 +331,10 @@ static void __dead2 stm32_system_off(void)
 {
 	uint32_t soc_mode = stm32mp1_get_lp_soc_mode(PSCI_MODE_SYSTEM_OFF);
 
+#if STM32MP_PARK_OFF_CPU
+	stm32_reset_parked_cpu();
+#endif
+
 	if (!stm32mp_is_single_core()) {
 		/* Prepare Core 1 reset */
 		mmio_setbits_32(stm32mp_rcc_base() + RCC_MP_GRSTCSETR,
@@ -807,6 +807,54 @@ bool stm32mp1_is_wakeup_from_standby(void)
 	return stm32_pm_context_is_valid();
 }
 
+#if defined(IMAGE_BL2)
+/*
+ * Return the RCC reset flags of the current boot, read once. With
+ * STM32MP_WARM_BOOT, they are then cleared, so that the flags of a power-on
+ * reset are not still set at the next warm reset.
+ */
+uint32_t stm32mp1_get_reset_status(void)
+{
+	static uint32_t rstsr;
+	static bool rstsr_read;
+
+	if (!rstsr_read) {
+		uintptr_t rstsclrr = stm32mp_rcc_base() + RCC_MP_RSTSCLRR;
+
+		rstsr = mmio_read_32(rstsclrr);
+#if STM32MP_WARM_BOOT
+		/* Write 1 to clear */
+		mmio_write_32(rstsclrr, rstsr);
+#endif
+		rstsr_read = true;
+	}
+
+	return rstsr;
+}
+
+/*
+ * A warm reset is a system reset requested by software or by a watchdog,
+ * without loss of power: DDR content may still be valid.
+ */
+bool stm32mp1_is_warm_reset(void)
+{
+	uint32_t rstsr = stm32mp1_get_reset_status();
+
+	if ((rstsr & (RCC_MP_RSTSCLRR_PORRSTF | RCC_MP_RSTSCLRR_BORRSTF)) !=
+	    0U) {
+		return false;
+	}
+
+	if (stm32mp1_is_wakeup_from_standby()) {
+		return false;
+	}
+
+	return (rstsr & (RCC_MP_RSTSCLRR_MPSYSRSTF |
+			 RCC_MP_RSTSCLRR_IWDG1RSTF |
+			 RCC_MP_RSTSCLRR_IWDG2RSTF)) != 0U;
+}
+#endif /* IMAGE_BL2 */
+
 int stm32_save_boot_interface(uint32_t interface, uint32_t instance)
 {
 	uint32_t bkpr_itf_idx = tamp_bkpr(TAMP_BOOT_ITF_BACKUP_REG_ID);
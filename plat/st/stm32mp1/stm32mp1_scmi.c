@@ -27,11 +27,17 @@
  * @clock_id: Clock identifier in RCC clock driver
  * @name: Clock string ID exposed to agent
  * @enabled: State of the SCMI clock
+ * @nsec_access: Non-secure access to the clock, resolved at server init
+ * @rate_cached: Rate read at server init, else read on each request
+ * @rate: Clock rate read at server init, valid if @rate_cached
  */
 struct stm32_scmi_clk {
 	unsigned long clock_id;
 	const char *name;
 	bool enabled;
+	bool nsec_access;
+	bool rate_cached;
+	unsigned long rate;
 };
 
 /*
@@ -219,22 +225,23 @@ const uint8_t *plat_scmi_protocol_list(unsigned int agent_id __unused)
 
 /*
  * Platform SCMI clocks
+ *
+ * The clock tables are indexed by SCMI clock ID and the non-secure access
+ * to each clock, which no longer changes once shared resources registering
+ * is locked, is resolved when the SCMI server is initialized. So is the
+ * rate of the clocks only the secure world can change, see
+ * clock_rate_is_static(). The others are read through the RCC driver.
  */
 static struct stm32_scmi_clk *find_clock(unsigned int agent_id,
 					 unsigned int scmi_id)
 {
 	const struct scmi_agent_resources *resource = find_resource(agent_id);
-	size_t n = 0U;
 
-	if (resource != NULL) {
-		for (n = 0U; n < resource->clock_count; n++) {
-			if (n == scmi_id) {
-				return &resource->clock[n];
-			}
-		}
+	if ((resource == NULL) || (scmi_id >= resource->clock_count)) {
+		return NULL;
 	}
 
-	return NULL;
+	return &resource->clock[scmi_id];
 }
 
 size_t plat_scmi_clock_count(unsigned int agent_id)
@@ -253,14 +260,34 @@ const char *plat_scmi_clock_get_name(unsigned int agent_id,
 {
 	struct stm32_scmi_clk *clock = find_clock(agent_id, scmi_id);
 
-	if ((clock == NULL) ||
-	    !stm32mp_nsec_can_access_clock(clock->clock_id)) {
+	if ((clock == NULL) || !clock->nsec_access) {
 		return NULL;
 	}
 
 	return clock->name;
 }
 
+/*
+ * The rate of a clock is static when the non-secure world cannot change any
+ * RCC register it depends on. PLL3 and the MCU clocks need MCKPROT on top of
+ * a secure RCC, PLL4 is always non-secure. SP_min only changes the MPU clock
+ * rate, on OPP switches.
+ */
+static bool clock_rate_is_static(struct stm32_scmi_clk *clock)
+{
+	return clock->nsec_access && (clock->clock_id != CK_MPU) &&
+	       stm32mp1_clk_rate_is_secure(clock->clock_id);
+}
+
+static unsigned long clock_rate(struct stm32_scmi_clk *clock)
+{
+	if (clock->rate_cached) {
+		return clock->rate;
+	}
+
+	return clk_get_rate(clock->clock_id);
+}
+
 int32_t plat_scmi_clock_rates_array(unsigned int agent_id, unsigned int scmi_id,
 				    unsigned long *array, size_t *nb_elts)
 {
@@ -281,7 +308,7 @@ int32_t plat_scmi_clock_rates_by_step(unsigned int agent_id,
 		return SCMI_NOT_FOUND;
 	}
 
-	if (!stm32mp_nsec_can_access_clock(clock->clock_id)) {
+	if (!clock->nsec_access) {
 		return SCMI_DENIED;
 	}
 
@@ -296,7 +323,7 @@ int32_t plat_scmi_clock_rates_by_step(unsigned int agent_id,
 		array[2] = 1U;
 		break;
 	default:
-		array[0] = clk_get_rate(clock->clock_id);
+		array[0] = clock_rate(clock);
 		array[1] = array[0];
 		array[2] = 0U;
 		break;
@@ -314,7 +341,7 @@ int32_t plat_scmi_clock_set_rate(unsigned int agent_id,
 		return SCMI_NOT_FOUND;
 	}
 
-	if (!stm32mp_nsec_can_access_clock(clock->clock_id)) {
+	if (!clock->nsec_access) {
 		return SCMI_DENIED;
 	}
 
@@ -325,7 +352,7 @@ int32_t plat_scmi_clock_set_rate(unsigned int agent_id,
 		}
 		break;
 	default:
-		if (rate != clk_get_rate(clock->clock_id)) {
+		if (rate != clock_rate(clock)) {
 			return SCMI_INVALID_PARAMETERS;
 		}
 		break;
@@ -339,20 +366,18 @@ unsigned long plat_scmi_clock_get_rate(unsigned int agent_id,
 {
 	struct stm32_scmi_clk *clock = find_clock(agent_id, scmi_id);
 
-	if ((clock == NULL) ||
-	    !stm32mp_nsec_can_access_clock(clock->clock_id)) {
+	if ((clock == NULL) || !clock->nsec_access) {
 		return 0U;
 	}
 
-	return clk_get_rate(clock->clock_id);
+	return clock_rate(clock);
 }
 
 int32_t plat_scmi_clock_get_state(unsigned int agent_id, unsigned int scmi_id)
 {
 	struct stm32_scmi_clk *clock = find_clock(agent_id, scmi_id);
 
-	if ((clock == NULL) ||
-	    !stm32mp_nsec_can_access_clock(clock->clock_id)) {
+	if ((clock == NULL) || !clock->nsec_access) {
 		return 0U;
 	}
 
@@ -368,7 +393,7 @@ int32_t plat_scmi_clock_set_state(unsigned int agent_id, unsigned int scmi_id,
 		return SCMI_NOT_FOUND;
 	}
 
-	if (!stm32mp_nsec_can_access_clock(clock->clock_id)) {
+	if (!clock->nsec_access) {
 		return SCMI_DENIED;
 	}
 
@@ -521,9 +546,16 @@ void stm32mp1_init_scmi_server(void)
 				panic();
 			}
 
+			clk->nsec_access =
+				stm32mp_nsec_can_access_clock(clk->clock_id);
+
+			clk->rate_cached = clock_rate_is_static(clk);
+			if (clk->rate_cached) {
+				clk->rate = clk_get_rate(clk->clock_id);
+			}
+
 			/* Sync SCMI clocks with their targeted initial state */
-			if (clk->enabled &&
-			    stm32mp_nsec_can_access_clock(clk->clock_id)) {
+			if (clk->enabled && clk->nsec_access) {
 				clk_enable(clk->clock_id);
 			}
 		}
@@ -714,11 +714,18 @@ static void check_rcc_secure_configuration(void)
 static void set_gpio_secure_configuration(void)
 {
 	uint32_t pin;
+	uint32_t secure = 0U;
 
 	for (pin = 0U; pin < get_gpioz_nbpin(); pin++) {
-		bool secure_state = periph_is_secure(STM32MP1_SHRES_GPIOZ(pin));
+		if (periph_is_secure(STM32MP1_SHRES_GPIOZ(pin))) {
+			secure |= BIT(pin);
+		}
+	}
 
-		set_gpio_secure_cfg(GPIO_BANK_Z, pin, secure_state);
+	if (get_gpioz_nbpin() != 0U) {
+		set_gpio_bank_secure_cfg(GPIO_BANK_Z,
+					 GENMASK(get_gpioz_nbpin() - 1U, 0),
+					 secure);
 	}
 }
 
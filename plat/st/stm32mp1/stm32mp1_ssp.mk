@@ -23,6 +23,8 @@ PLAT_BL_COMMON_SOURCES	:=	common/fdt_wrappers.c					\
 
 PLAT_BL_COMMON_SOURCES	+=	${XLAT_TABLES_LIB_SRCS}
 
+PLAT_BL_COMMON_SOURCES	+=	${CHECKSUM_SOURCES}
+
 PLAT_BL_COMMON_SOURCES	+=	lib/cpus/aarch32/cortex_a7.S
 
 PLAT_BL_COMMON_SOURCES	+=	drivers/st/uart/aarch32/stm32_console.S
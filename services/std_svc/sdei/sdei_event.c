@@ -1,11 +1,12 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
 
+#include <common/debug.h>
 #include <lib/utils.h>
 
 #include "sdei_private.h"
@@ -51,6 +52,121 @@ sdei_entry_t *get_event_entry(sdei_ev_map_t *map)
 	}
 }
 
+/*
+ * Lookup tables built by sdei_init_event_index(). Entries hold a global map
+ * index, private mappings first then shared ones, biased by one so that zero
+ * denotes an empty slot.
+ */
+static uint16_t sdei_ev_index[SDEI_EV_INDEX_SIZE];
+static uint16_t sdei_intr_index[SDEI_INTR_INDEX_MAX];
+
+static unsigned int map_to_index(sdei_ev_map_t *map)
+{
+	const sdei_mapping_t *mapping;
+
+	if (is_event_private(map)) {
+		mapping = SDEI_PRIVATE_MAPPING();
+		return (unsigned int) MAP_OFF(map, mapping) + 1U;
+	}
+
+	mapping = SDEI_SHARED_MAPPING();
+	return (unsigned int) (SDEI_PRIVATE_MAPPING()->num_maps +
+			(size_t) MAP_OFF(map, mapping)) + 1U;
+}
+
+static sdei_ev_map_t *index_to_map(unsigned int idx)
+{
+	const sdei_mapping_t *mapping = SDEI_PRIVATE_MAPPING();
+
+	assert(idx != 0U);
+	idx--;
+
+	if (idx < mapping->num_maps)
+		return &mapping->map[idx];
+
+	idx -= (unsigned int) mapping->num_maps;
+	mapping = SDEI_SHARED_MAPPING();
+	assert(idx < mapping->num_maps);
+
+	return &mapping->map[idx];
+}
+
+/* Multiplicative hash of an event number into the event lookup table */
+static unsigned int ev_hash(int ev_num)
+{
+	return ((uint32_t) ev_num * 0x9e3779b1U) >>
+		(32U - PLAT_SDEI_EV_INDEX_SHIFT);
+}
+
+static bool is_intr_indexed(unsigned int intr_num)
+{
+	/*
+	 * SDEI_DYN_IRQ denotes free dynamic slots, of which there can be
+	 * several; those are looked up linearly.
+	 */
+	return (intr_num != SDEI_DYN_IRQ) && (intr_num < SDEI_INTR_INDEX_MAX);
+}
+
+/*
+ * Build the event number and interrupt lookup tables from the platform
+ * mappings. Must be called once the mappings have been validated and static
+ * events marked as bound.
+ */
+void sdei_init_event_index(void)
+{
+	const sdei_mapping_t *mapping;
+	sdei_ev_map_t *map;
+	unsigned int i, j, slot, probes;
+
+	zeromem(sdei_ev_index, sizeof(sdei_ev_index));
+	zeromem(sdei_intr_index, sizeof(sdei_intr_index));
+
+	if ((SDEI_PRIVATE_MAPPING()->num_maps +
+	     SDEI_SHARED_MAPPING()->num_maps) > (SDEI_EV_INDEX_SIZE / 2U)) {
+		ERROR("SDEI: event index too small\n");
+		panic();
+	}
+
+	for_each_mapping_type(i, mapping) {
+		iterate_mapping(mapping, j, map) {
+			slot = ev_hash(map->ev_num);
+			for (probes = 0U; sdei_ev_index[slot] != 0U; probes++) {
+				/* Event numbers must be unique */
+				assert(index_to_map(sdei_ev_index[slot])->ev_num !=
+				       map->ev_num);
+				assert(probes < SDEI_EV_INDEX_SIZE);
+				slot = (slot + 1U) & (SDEI_EV_INDEX_SIZE - 1U);
+			}
+			sdei_ev_index[slot] = (uint16_t) map_to_index(map);
+
+			if (is_intr_indexed(map->intr)) {
+				/* An interrupt can back at most one event */
+				assert(sdei_intr_index[map->intr] == 0U);
+				sdei_intr_index_set(map);
+			}
+		}
+	}
+}
+
+/* Record the interrupt currently bound to a mapping */
+void sdei_intr_index_set(sdei_ev_map_t *map)
+{
+	if (!is_intr_indexed(map->intr))
+		return;
+
+	sdei_intr_index[map->intr] = (uint16_t) map_to_index(map);
+}
+
+/* Forget the interrupt bound to a mapping, ahead of it being released */
+void sdei_intr_index_clear(sdei_ev_map_t *map)
+{
+	if (!is_intr_indexed(map->intr))
+		return;
+
+	if (sdei_intr_index[map->intr] == (uint16_t) map_to_index(map))
+		sdei_intr_index[map->intr] = 0U;
+}
+
 /*
  * Find event mapping for a given interrupt number: On success, returns pointer
  * to the event mapping. On error, returns NULL.
@@ -61,11 +177,23 @@ sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared)
 	sdei_ev_map_t *map;
 	unsigned int i;
 
-	/*
-	 * Look for a match in private and shared mappings, as requested. This
-	 * is a linear search. However, if the mappings are required to be
-	 * sorted, for large maps, we could consider binary search.
-	 */
+	if (is_intr_indexed(intr_num)) {
+		i = sdei_intr_index[intr_num];
+		if (i == 0U)
+			return NULL;
+
+		/*
+		 * The mapping may be concurrently released; report a match only
+		 * if it still refers to the interrupt, as a linear search would.
+		 */
+		map = index_to_map(i);
+		if ((is_event_shared(map) != shared) || (map->intr != intr_num))
+			return NULL;
+
+		return map;
+	}
+
+	/* Look for a match in private and shared mappings, as requested */
 	mapping = shared ? SDEI_SHARED_MAPPING() : SDEI_PRIVATE_MAPPING();
 	iterate_mapping(mapping, i, map) {
 		if (map->intr == intr_num)
@@ -81,20 +209,19 @@ sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared)
  */
 sdei_ev_map_t *find_event_map(int ev_num)
 {
-	const sdei_mapping_t *mapping;
 	sdei_ev_map_t *map;
-	unsigned int i, j;
+	unsigned int slot, probes;
 
-	/*
-	 * Iterate through mappings to find a match. This is a linear search.
-	 * However, if the mappings are required to be sorted, for large maps,
-	 * we could consider binary search.
-	 */
-	for_each_mapping_type(i, mapping) {
-		iterate_mapping(mapping, j, map) {
-			if (map->ev_num == ev_num)
-				return map;
-		}
+	slot = ev_hash(ev_num);
+	for (probes = 0U; probes < SDEI_EV_INDEX_SIZE; probes++) {
+		if (sdei_ev_index[slot] == 0U)
+			break;
+
+		map = index_to_map(sdei_ev_index[slot]);
+		if (map->ev_num == ev_num)
+			return map;
+
+		slot = (slot + 1U) & (SDEI_EV_INDEX_SIZE - 1U);
 	}
 
 	return NULL;
@@ -14,6 +14,8 @@
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <lib/cassert.h>
+#include <lib/pmf/pmf.h>
+#include <lib/runtime_instr.h>
 #include <services/sdei.h>
 
 #include "sdei_private.h"
@@ -373,6 +375,12 @@ int sdei_intr_handler(uint32_t intr_raw, uint32_t flags, void *handle,
 	 * Find if this is an SDEI interrupt. There must be an event mapped to
 	 * this interrupt
 	 */
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_ENTER_SDEI_DISPATCH,
+	    PMF_NO_CACHE_MAINT);
+#endif
+
 	intr = plat_ic_get_interrupt_id(intr_raw);
 	map = find_event_map_by_intr(intr, (plat_ic_is_spi(intr) != 0));
 	if (map == NULL) {
@@ -482,6 +490,13 @@ int sdei_intr_handler(uint32_t intr_raw, uint32_t flags, void *handle,
 
 	/* Synchronously dispatch event */
 	setup_ns_dispatch(map, se, ctx, &dispatch_jmp);
+
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_EXIT_SDEI_DISPATCH,
+	    PMF_NO_CACHE_MAINT);
+#endif
+
 	begin_sdei_synchronous_dispatch(&dispatch_jmp);
 
 	/*
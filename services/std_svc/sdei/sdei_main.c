@@ -229,6 +229,7 @@ void sdei_init(void)
 	plat_sdei_setup();
 	sdei_class_init(SDEI_CRITICAL);
 	sdei_class_init(SDEI_NORMAL);
+	sdei_init_event_index();
 
 	/* Register priority level handlers */
 	ehf_register_priority_handler(PLAT_SDEI_CRITICAL_PRI,
@@ -749,6 +750,7 @@ static int sdei_interrupt_bind(unsigned int intr_num)
 		if (!is_map_bound(map)) {
 			map->intr = intr_num;
 			set_map_bound(map);
+			sdei_intr_index_set(map);
 			retry = false;
 		}
 		sdei_map_unlock(map);
@@ -806,6 +808,7 @@ static int sdei_interrupt_release(int ev_num)
 		 * during unregister.
 		 */
 
+		sdei_intr_index_clear(map);
 		map->intr = SDEI_DYN_IRQ;
 		clr_map_bound(map);
 	} else {
@@ -34,6 +34,23 @@
 # error Platform must define SDEI normal priority value
 #endif
 
+/*
+ * Log2 of the number of slots in the event number lookup table. It must hold
+ * all private and shared mappings, and should be at least twice as large to
+ * keep probe sequences short.
+ */
+#ifndef PLAT_SDEI_EV_INDEX_SHIFT
+# define PLAT_SDEI_EV_INDEX_SHIFT	6U
+#endif
+
+#define SDEI_EV_INDEX_SIZE	(1U << PLAT_SDEI_EV_INDEX_SHIFT)
+
+/*
+ * Interrupt IDs below this limit (SGIs, PPIs and SPIs) are looked up through a
+ * direct table. Extended PPI/SPI ranges fall back to a linear search.
+ */
+#define SDEI_INTR_INDEX_MAX	1020U
+
 /* Output SDEI logs as verbose */
 #define SDEI_LOG(...)	VERBOSE("SDEI: " __VA_ARGS__)
 
@@ -229,6 +246,9 @@ extern sdei_entry_t sdei_private_event_table[];
 extern sdei_entry_t sdei_shared_event_table[];
 
 void init_sdei_state(void);
+void sdei_init_event_index(void);
+void sdei_intr_index_set(sdei_ev_map_t *map);
+void sdei_intr_index_clear(sdei_ev_map_t *map);
 
 sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared);
 sdei_ev_map_t *find_event_map(int ev_num);
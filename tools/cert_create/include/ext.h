@@ -14,7 +14,8 @@
 enum ext_type_e {
 	EXT_TYPE_NVCOUNTER,
 	EXT_TYPE_PKEY,
-	EXT_TYPE_HASH
+	EXT_TYPE_HASH,
+	EXT_TYPE_HASH_LIST
 };
 
 /* NV-Counter types */
@@ -46,6 +47,8 @@ typedef struct ext_s {
 	union {
 		int nvctr_type;	/* See nvctr_type_e */
 		int key;	/* Index into array of registered public keys */
+		int ext;	/* Index of the extension giving the image file
+				 * hashed in a list (EXT_TYPE_HASH_LIST) */
 	} attr;
 
 	int alias;		/* In case OpenSSL provides an standard
@@ -70,6 +73,9 @@ int ext_init(void);
 ext_t *ext_get_by_opt(const char *opt);
 X509_EXTENSION *ext_new_hash(int nid, int crit, const EVP_MD *md,
 		unsigned char *buf, size_t len);
+X509_EXTENSION *ext_new_hash_list(int nid, int crit, const EVP_MD *md,
+		unsigned long chunk_size, unsigned char *buf, size_t len,
+		unsigned int num);
 X509_EXTENSION *ext_new_nvcounter(int nid, int crit, int value);
 X509_EXTENSION *ext_new_key(int nid, int crit, EVP_PKEY *k);
 
@@ -8,5 +8,7 @@
 #define SHA_H
 
 int sha_file(int md_alg, const char *filename, unsigned char *md);
+int sha_file_chunks(int md_alg, const char *filename, unsigned long chunk_size,
+		    unsigned char **md_list, unsigned int *num);
 
 #endif /* SHA_H */
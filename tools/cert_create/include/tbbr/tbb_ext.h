@@ -30,6 +30,7 @@ enum {
 	TRUSTED_OS_FW_CONFIG_HASH_EXT,
 	NON_TRUSTED_FW_CONTENT_CERT_PK_EXT,
 	NON_TRUSTED_WORLD_BOOTLOADER_HASH_EXT,
+	NON_TRUSTED_WORLD_BOOTLOADER_CHUNK_HASHES_EXT,
 	NON_TRUSTED_FW_CONFIG_HASH_EXT,
 	SP_PKG1_HASH_EXT,
 	SP_PKG2_HASH_EXT,
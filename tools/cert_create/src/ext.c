@@ -6,6 +6,7 @@
 
 #include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <openssl/asn1.h>
 #include <openssl/asn1t.h>
@@ -133,31 +134,12 @@ X509_EXTENSION *ext_new(int nid, int crit, unsigned char *data, int len)
 }
 
 /*
- * Creates a x509v3 extension containing a hash
- *
- * DigestInfo ::= SEQUENCE {
- *     digestAlgorithm  AlgorithmIdentifier,
- *     digest           OCTET STRING
- * }
- *
- * AlgorithmIdentifier ::=  SEQUENCE  {
- *     algorithm        OBJECT IDENTIFIER,
- *     parameters       ANY DEFINED BY algorithm OPTIONAL
- * }
- *
- * Parameters:
- *   nid: extension identifier
- *   crit: extension critical (EXT_NON_CRIT, EXT_CRIT)
- *   md: hash algorithm
- *   buf: pointer to the buffer that contains the hash
- *   len: size of the hash in bytes
- *
- * Return: Extension address, NULL if error
+ * Encodes a hash as a DigestInfo structure. On success, '*der' points to the
+ * encoding, to be released with OPENSSL_free(), and its size is returned.
  */
-X509_EXTENSION *ext_new_hash(int nid, int crit, const EVP_MD *md,
-		unsigned char *buf, size_t len)
+static int hash_to_der(const EVP_MD *md, unsigned char *buf, size_t len,
+		       unsigned char **der)
 {
-	X509_EXTENSION *ex;
 	ASN1_OCTET_STRING *octet;
 	HASH *hash;
 	ASN1_OBJECT *algorithm;
@@ -168,13 +150,13 @@ X509_EXTENSION *ext_new_hash(int nid, int crit, const EVP_MD *md,
 	/* OBJECT_IDENTIFIER with hash algorithm */
 	algorithm = OBJ_nid2obj(EVP_MD_type(md));
 	if (algorithm == NULL) {
-		return NULL;
+		return -1;
 	}
 
 	/* Create X509_ALGOR */
 	x509_algor = X509_ALGOR_new();
 	if (x509_algor == NULL) {
-		return NULL;
+		return -1;
 	}
 	x509_algor->algorithm = algorithm;
 	x509_algor->parameter = ASN1_TYPE_new();
@@ -184,7 +166,7 @@ X509_EXTENSION *ext_new_hash(int nid, int crit, const EVP_MD *md,
 	octet = ASN1_OCTET_STRING_new();
 	if (octet == NULL) {
 		X509_ALGOR_free(x509_algor);
-		return NULL;
+		return -1;
 	}
 	ASN1_OCTET_STRING_set(octet, buf, len);
 
@@ -193,16 +175,55 @@ X509_EXTENSION *ext_new_hash(int nid, int crit, const EVP_MD *md,
 	if (hash == NULL) {
 		ASN1_OCTET_STRING_free(octet);
 		X509_ALGOR_free(x509_algor);
-		return NULL;
+		return -1;
 	}
 	hash->hashAlgorithm = x509_algor;
 	hash->dataHash = octet;
 
 	/* DER encoded HASH */
 	sz = i2d_HASH(hash, &p);
+	HASH_free(hash);
 	if ((sz <= 0) || (p == NULL)) {
-		HASH_free(hash);
-		X509_ALGOR_free(x509_algor);
+		return -1;
+	}
+
+	*der = p;
+
+	return sz;
+}
+
+/*
+ * Creates a x509v3 extension containing a hash
+ *
+ * DigestInfo ::= SEQUENCE {
+ *     digestAlgorithm  AlgorithmIdentifier,
+ *     digest           OCTET STRING
+ * }
+ *
+ * AlgorithmIdentifier ::=  SEQUENCE  {
+ *     algorithm        OBJECT IDENTIFIER,
+ *     parameters       ANY DEFINED BY algorithm OPTIONAL
+ * }
+ *
+ * Parameters:
+ *   nid: extension identifier
+ *   crit: extension critical (EXT_NON_CRIT, EXT_CRIT)
+ *   md: hash algorithm
+ *   buf: pointer to the buffer that contains the hash
+ *   len: size of the hash in bytes
+ *
+ * Return: Extension address, NULL if error
+ */
+X509_EXTENSION *ext_new_hash(int nid, int crit, const EVP_MD *md,
+		unsigned char *buf, size_t len)
+{
+	X509_EXTENSION *ex;
+	unsigned char *p = NULL;
+	int sz;
+
+	/* DER encoded HASH */
+	sz = hash_to_der(md, buf, len, &p);
+	if (sz <= 0) {
 		return NULL;
 	}
 
@@ -211,7 +232,6 @@ X509_EXTENSION *ext_new_hash(int nid, int crit, const EVP_MD *md,
 
 	/* Clean up */
 	OPENSSL_free(p);
-	HASH_free(hash);
 
 	return ex;
 }
@@ -250,6 +270,116 @@ X509_EXTENSION *ext_new_nvcounter(int nid, int crit, int value)
 	return ex;
 }
 
+/*
+ * Writes a DER tag and definite length at 'p' (if not NULL) and returns the
+ * number of bytes it takes
+ */
+static size_t der_put_header(unsigned char *p, unsigned char tag, size_t len)
+{
+	size_t n, hdr_len = 0;
+
+	for (n = len; (len >= 0x80) && (n != 0); n >>= 8) {
+		hdr_len++;
+	}
+
+	if (p != NULL) {
+		p[0] = tag;
+		if (hdr_len == 0) {
+			p[1] = (unsigned char)len;
+		} else {
+			p[1] = 0x80 | (unsigned char)hdr_len;
+			for (n = 0; n < hdr_len; n++) {
+				p[1 + hdr_len - n] = (unsigned char)(len >> (8 * n));
+			}
+		}
+	}
+
+	return 2 + hdr_len;
+}
+
+/*
+ * Creates a x509v3 extension containing the hashes of the successive chunks of
+ * an image, so the image can be verified while it is being loaded:
+ *
+ * HashList ::= SEQUENCE {
+ *     chunkSize        INTEGER,
+ *     chunkHashes      SEQUENCE OF DigestInfo
+ * }
+ *
+ * Each DigestInfo entry is encoded as in ext_new_hash().
+ *
+ * Parameters:
+ *   nid: extension identifier
+ *   crit: extension critical (EXT_NON_CRIT, EXT_CRIT)
+ *   md: hash algorithm
+ *   chunk_size: size of the chunks in bytes
+ *   buf: pointer to the buffer that contains the 'num' consecutive hashes
+ *   len: size of one hash in bytes
+ *   num: number of chunks
+ *
+ * Return: Extension address, NULL if error
+ */
+X509_EXTENSION *ext_new_hash_list(int nid, int crit, const EVP_MD *md,
+		unsigned long chunk_size, unsigned char *buf, size_t len,
+		unsigned int num)
+{
+	X509_EXTENSION *ex = NULL;
+	ASN1_INTEGER *size;
+	unsigned char *p = NULL, *q = NULL, *der = NULL, *entry;
+	size_t list_len, seq_len;
+	unsigned int i;
+	int sz, entry_sz;
+
+	/* Encode chunk size */
+	size = ASN1_INTEGER_new();
+	if ((size == NULL) || !ASN1_INTEGER_set(size, chunk_size)) {
+		ASN1_INTEGER_free(size);
+		return NULL;
+	}
+	sz = i2d_ASN1_INTEGER(size, &p);
+	ASN1_INTEGER_free(size);
+	if ((sz <= 0) || (p == NULL)) {
+		return NULL;
+	}
+
+	/* Encode the DigestInfo of each chunk. All have the same length */
+	for (i = 0; i < num; i++) {
+		entry = NULL;
+		entry_sz = hash_to_der(md, buf + (i * len), len, &entry);
+		if (entry_sz <= 0) {
+			goto out;
+		}
+		if (der == NULL) {
+			list_len = (size_t)entry_sz * num;
+			seq_len = sz + der_put_header(NULL, 0x30, list_len) +
+				  list_len;
+			der = malloc(der_put_header(NULL, 0x30, seq_len) +
+				     seq_len);
+			if (der == NULL) {
+				OPENSSL_free(entry);
+				goto out;
+			}
+			q = der + der_put_header(der, 0x30, seq_len);
+			memcpy(q, p, sz);
+			q += sz;
+			q += der_put_header(q, 0x30, list_len);
+		}
+		memcpy(q, entry, entry_sz);
+		q += entry_sz;
+		OPENSSL_free(entry);
+	}
+
+	if (der != NULL) {
+		ex = ext_new(nid, crit, der, q - der);
+	}
+
+out:
+	free(der);
+	OPENSSL_free(p);
+
+	return ex;
+}
+
 /*
  * Creates a x509v3 extension containing a public key in DER format:
  *
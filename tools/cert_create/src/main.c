@@ -250,6 +250,25 @@ static void check_cmd_params(void)
 					exit(1);
 				}
 				break;
+			case EXT_TYPE_HASH_LIST:
+				/*
+				 * Chunk size, if specified, must be valid and
+				 * the image to hash must be given as well.
+				 */
+				if (ext->arg == NULL) {
+					break;
+				}
+				if (strtoul(ext->arg, NULL, 0) == 0) {
+					ERROR("Invalid chunk size for '%s'\n",
+					      ext->ln);
+					exit(1);
+				}
+				if (extensions[ext->attr.ext].arg == NULL) {
+					ERROR("Image for '%s' not specified\n",
+					      ext->ln);
+					exit(1);
+				}
+				break;
 			default:
 				ERROR("Unknown extension type '%d' in '%s'\n",
 				      ext->type, ext->ln);
@@ -306,7 +325,8 @@ int main(int argc, char *argv[])
 	const char *cur_opt;
 	unsigned int err_code;
 	unsigned char md[SHA512_DIGEST_LENGTH];
-	unsigned int  md_len;
+	unsigned char *md_list;
+	unsigned int  md_len, md_num;
 	const EVP_MD *md_info;
 
 	NOTICE("CoT Generation Tool: %s\n", build_msg);
@@ -486,9 +506,10 @@ int main(int argc, char *argv[])
 			CHECK_OID(ext_nid, ext->oid);
 
 			/*
-			 * Three types of extensions are currently supported:
+			 * Four types of extensions are currently supported:
 			 *     - EXT_TYPE_NVCOUNTER
 			 *     - EXT_TYPE_HASH
+			 *     - EXT_TYPE_HASH_LIST
 			 *     - EXT_TYPE_PKEY
 			 */
 			switch (ext->type) {
@@ -520,6 +541,26 @@ int main(int argc, char *argv[])
 						EXT_CRIT, md_info, md,
 						md_len));
 				break;
+			case EXT_TYPE_HASH_LIST:
+				if (ext->arg == NULL) {
+					/* Chunk hashes not requested */
+					continue;
+				}
+				/* Calculate the hashes of the file chunks */
+				if (!sha_file_chunks(hash_alg,
+						extensions[ext->attr.ext].arg,
+						strtoul(ext->arg, NULL, 0),
+						&md_list, &md_num)) {
+					ERROR("Cannot calculate hashes of %s\n",
+						extensions[ext->attr.ext].arg);
+					exit(1);
+				}
+				CHECK_NULL(cert_ext, ext_new_hash_list(ext_nid,
+						EXT_CRIT, md_info,
+						strtoul(ext->arg, NULL, 0),
+						md_list, md_len, md_num));
+				free(md_list);
+				break;
 			case EXT_TYPE_PKEY:
 				CHECK_NULL(cert_ext, ext_new_key(ext_nid,
 					EXT_CRIT, keys[ext->attr.key].key));
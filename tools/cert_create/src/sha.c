@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <openssl/evp.h>
 #include <openssl/sha.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include "debug.h"
 #include "key.h"
 
@@ -53,3 +55,85 @@ int sha_file(int md_alg, const char *filename, unsigned char *md)
 	fclose(inFile);
 	return 1;
 }
+
+/*
+ * Hash a file in chunks of 'chunk_size' bytes, the last one being possibly
+ * shorter. The digests of the successive chunks are returned in a list
+ * allocated by this function, to be freed by the caller.
+ */
+int sha_file_chunks(int md_alg, const char *filename, unsigned long chunk_size,
+		    unsigned char **md_list, unsigned int *num)
+{
+	FILE *inFile;
+	EVP_MD_CTX *ctx;
+	const EVP_MD *md_info;
+	unsigned char *list = NULL;
+	unsigned char *data;
+	unsigned int md_len, count = 0;
+	size_t bytes;
+	int ret = 0;
+
+	if ((filename == NULL) || (md_list == NULL) || (num == NULL) ||
+	    (chunk_size == 0)) {
+		ERROR("%s(): invalid argument\n", __FUNCTION__);
+		return 0;
+	}
+
+	if (md_alg == HASH_ALG_SHA384) {
+		md_info = EVP_sha384();
+	} else if (md_alg == HASH_ALG_SHA512) {
+		md_info = EVP_sha512();
+	} else {
+		md_info = EVP_sha256();
+	}
+	md_len = EVP_MD_size(md_info);
+
+	inFile = fopen(filename, "rb");
+	if (inFile == NULL) {
+		ERROR("Cannot read %s\n", filename);
+		return 0;
+	}
+
+	data = malloc(chunk_size);
+	ctx = EVP_MD_CTX_create();
+	if ((data == NULL) || (ctx == NULL)) {
+		ERROR("%s(): out of memory\n", __FUNCTION__);
+		goto out;
+	}
+
+	while ((bytes = fread(data, 1, chunk_size, inFile)) != 0) {
+		unsigned char *new_list;
+
+		new_list = realloc(list, (count + 1) * md_len);
+		if (new_list == NULL) {
+			ERROR("%s(): out of memory\n", __FUNCTION__);
+			goto out;
+		}
+		list = new_list;
+
+		if (!EVP_DigestInit_ex(ctx, md_info, NULL) ||
+		    !EVP_DigestUpdate(ctx, data, bytes) ||
+		    !EVP_DigestFinal_ex(ctx, list + (count * md_len), NULL)) {
+			ERROR("Cannot hash %s\n", filename);
+			goto out;
+		}
+		count++;
+	}
+
+	if (ferror(inFile) || (count == 0)) {
+		ERROR("Cannot read %s\n", filename);
+		goto out;
+	}
+
+	*md_list = list;
+	*num = count;
+	list = NULL;
+	ret = 1;
+
+out:
+	free(list);
+	free(data);
+	EVP_MD_CTX_destroy(ctx);
+	fclose(inFile);
+	return ret;
+}
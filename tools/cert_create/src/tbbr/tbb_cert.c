@@ -162,8 +162,9 @@ static cert_t tbb_certs[] = {
 			NON_TRUSTED_FW_NVCOUNTER_EXT,
 			NON_TRUSTED_WORLD_BOOTLOADER_HASH_EXT,
 			NON_TRUSTED_FW_CONFIG_HASH_EXT,
+			NON_TRUSTED_WORLD_BOOTLOADER_CHUNK_HASHES_EXT,
 		},
-		.num_ext = 3
+		.num_ext = 4
 	},
 	[SIP_SECURE_PARTITION_CONTENT_CERT] = {
 		.id = SIP_SECURE_PARTITION_CONTENT_CERT,
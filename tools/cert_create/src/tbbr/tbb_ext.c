@@ -203,6 +203,17 @@ static ext_t tbb_ext[] = {
 		.asn1_type = V_ASN1_OCTET_STRING,
 		.type = EXT_TYPE_HASH
 	},
+	[NON_TRUSTED_WORLD_BOOTLOADER_CHUNK_HASHES_EXT] = {
+		.oid = NON_TRUSTED_WORLD_BOOTLOADER_CHUNK_HASHES_OID,
+		.opt = "nt-fw-chunk-size",
+		.help_msg = "Size of the chunks of the Non-Trusted World Bootloader image hashed separately",
+		.sn = "NonTrustedWorldBootloaderChunkHashes",
+		.ln = "Non-Trusted World chunk hashes",
+		.asn1_type = V_ASN1_SEQUENCE,
+		.type = EXT_TYPE_HASH_LIST,
+		.attr.ext = NON_TRUSTED_WORLD_BOOTLOADER_HASH_EXT,
+		.optional = 1
+	},
 	[NON_TRUSTED_FW_CONFIG_HASH_EXT] = {
 		.oid = NON_TRUSTED_FW_CONFIG_HASH_OID,
 		.opt = "nt-fw-config",
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host check of the software implementation of lib/checksum: known answers,
+ * then random buffers at every alignment and in chunks against bitwise
+ * references, then the throughput of each function.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <lib/checksum.h>
+
+#define CRC32_POLY		0xEDB88320U
+#define CRC32C_POLY		0x82F63B78U
+
+#define RANDOM_BUF_SIZE		4096U
+#define RANDOM_RUNS		2000U
+#define BENCH_BUF_SIZE		(1U << 20)
+#define BENCH_MIN_SECONDS	0.5
+
+struct known_answer {
+	const char *data;
+	uint32_t crc32;
+	uint32_t crc32c;
+};
+
+/* Check values from the RFC 3720 and the CRC catalogue */
+static const struct known_answer known_answers[] = {
+	{ "", 0x00000000U, 0x00000000U },
+	{ "a", 0xE8B7BE43U, 0xC1D04330U },
+	{ "123456789", 0xCBF43926U, 0xE3069283U },
+	{ "The quick brown fox jumps over the lazy dog",
+	  0x414FA339U, 0x22620404U },
+};
+
+static unsigned int failures;
+
+static void check(int ok, const char *what, size_t off, size_t len)
+{
+	if (!ok) {
+		fprintf(stderr, "FAIL: %s, offset %zu, length %zu\n",
+			what, off, len);
+		failures++;
+	}
+}
+
+static uint32_t crc_ref(uint32_t poly, uint32_t crc, const uint8_t *buf,
+			size_t len)
+{
+	unsigned int i;
+
+	crc = ~crc;
+
+	while (len-- != 0U) {
+		crc ^= *buf++;
+		for (i = 0U; i < 8U; i++) {
+			crc = (crc >> 1) ^ (((crc & 1U) != 0U) ? poly : 0U);
+		}
+	}
+
+	return ~crc;
+}
+
+static uint32_t add8_ref(uint32_t sum, const uint8_t *buf, size_t len)
+{
+	while (len-- != 0U) {
+		sum += *buf++;
+	}
+
+	return sum;
+}
+
+static uint8_t xor8_ref(uint8_t xor, const uint8_t *buf, size_t len)
+{
+	while (len-- != 0U) {
+		xor ^= *buf++;
+	}
+
+	return xor;
+}
+
+static void test_known_answers(void)
+{
+	unsigned int i;
+
+	for (i = 0U; i < sizeof(known_answers) / sizeof(known_answers[0]);
+	     i++) {
+		const struct known_answer *ka = &known_answers[i];
+		size_t len = strlen(ka->data);
+
+		check(checksum_crc32(0U, ka->data, len) == ka->crc32,
+		      "CRC32 known answer", 0U, len);
+		check(checksum_crc32c(0U, ka->data, len) == ka->crc32c,
+		      "CRC32C known answer", 0U, len);
+	}
+}
+
+/* Random lengths at every word alignment, computed whole and in 2 chunks */
+static void test_random(void)
+{
+	static uint8_t buf[RANDOM_BUF_SIZE + 4U];
+	unsigned int run;
+	size_t i;
+
+	srand(0x5EED);
+
+	for (i = 0U; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)rand();
+	}
+
+	for (run = 0U; run < RANDOM_RUNS; run++) {
+		size_t off = run & 3U;
+		size_t len = (size_t)rand() % (RANDOM_BUF_SIZE + 1U);
+		size_t cut = (len == 0U) ? 0U : ((size_t)rand() % len);
+		const uint8_t *p = buf + off;
+		uint32_t crc32 = crc_ref(CRC32_POLY, 0U, p, len);
+		uint32_t crc32c = crc_ref(CRC32C_POLY, 0U, p, len);
+		uint32_t sum = (uint32_t)rand();
+		uint8_t xor = (uint8_t)rand();
+
+		check(checksum_crc32(0U, p, len) == crc32, "CRC32", off, len);
+		check(checksum_crc32(checksum_crc32(0U, p, cut), p + cut,
+				     len - cut) == crc32,
+		      "CRC32 in chunks", off, len);
+		check(checksum_crc32c(0U, p, len) == crc32c, "CRC32C", off,
+		      len);
+		check(checksum_crc32c(checksum_crc32c(0U, p, cut), p + cut,
+				      len - cut) == crc32c,
+		      "CRC32C in chunks", off, len);
+		check(checksum_add8(sum, p, len) == add8_ref(sum, p, len),
+		      "sum", off, len);
+		check(checksum_xor8(xor, p, len) == xor8_ref(xor, p, len),
+		      "XOR", off, len);
+	}
+
+	/* All bytes 0xFF stress the 16-bit lanes of checksum_add8() */
+	memset(buf, 0xFF, sizeof(buf));
+	check(checksum_add8(0U, buf, sizeof(buf)) ==
+	      add8_ref(0U, buf, sizeof(buf)), "sum of 0xFF", 0U, sizeof(buf));
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+static volatile uint32_t bench_sink;
+
+static void bench(const char *name, int fn, const uint8_t *buf)
+{
+	double start = now();
+	double elapsed;
+	unsigned int loops = 0U;
+
+	do {
+		switch (fn) {
+		case 0:
+			bench_sink = checksum_crc32(0U, buf, BENCH_BUF_SIZE);
+			break;
+		case 1:
+			bench_sink = checksum_crc32c(0U, buf, BENCH_BUF_SIZE);
+			break;
+		case 2:
+			bench_sink = checksum_add8(0U, buf, BENCH_BUF_SIZE);
+			break;
+		default:
+			bench_sink = checksum_xor8(0U, buf, BENCH_BUF_SIZE);
+			break;
+		}
+		loops++;
+		elapsed = now() - start;
+	} while (elapsed < BENCH_MIN_SECONDS);
+
+	printf("  %-8s %8.1f MiB/s\n", name,
+	       ((double)loops * BENCH_BUF_SIZE) / (elapsed * 1024.0 * 1024.0));
+}
+
+int main(void)
+{
+	uint8_t *buf;
+
+	test_known_answers();
+	test_random();
+
+	if (failures != 0U) {
+		fprintf(stderr, "%u checks failed\n", failures);
+		return EXIT_FAILURE;
+	}
+
+	printf("All checks passed\n");
+
+	buf = malloc(BENCH_BUF_SIZE);
+	if (buf == NULL) {
+		return EXIT_FAILURE;
+	}
+	memset(buf, 0xA5, BENCH_BUF_SIZE);
+
+	printf("Software throughput:\n");
+	bench("crc32", 0, buf);
+	bench("crc32c", 1, buf);
+	bench("add8", 2, buf);
+	bench("xor8", 3, buf);
+
+	free(buf);
+
+	return EXIT_SUCCESS;
+}
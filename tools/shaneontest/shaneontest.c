@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host check of the NEON SHA-512 block function of
+ * drivers/auth/mbedtls/aarch32/sha512_neon.S: the FIPS 180-4 examples for
+ * SHA-512 and SHA-384, then random states, blocks and messages at every
+ * alignment against a C reference, then the throughput of both.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SHA512_BLOCK_SIZE	128U
+
+#define RANDOM_BUF_SIZE		2048U
+#define RANDOM_RUNS		2000U
+#define BENCH_BUF_SIZE		(1U << 20)
+#define BENCH_MIN_SECONDS	0.5
+
+typedef void (*block_fn_t)(uint64_t state[8], const uint8_t *data);
+
+void sha512_block_neon(uint64_t state[8], const uint8_t data[128]);
+
+struct known_answer {
+	const char *data;
+	size_t repeat;
+	const char *sha512;
+	const char *sha384;
+};
+
+/* Examples of FIPS 180-4 and of the NIST test vectors */
+static const struct known_answer known_answers[] = {
+	{ "abc", 1U,
+	  "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+	  "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f",
+	  "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed"
+	  "8086072ba1e7cc2358baeca134c825a7" },
+	{ "", 1U,
+	  "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce"
+	  "47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e",
+	  "38b060a751ac96384cd9327eb1b1e36a21fdb71114be07434c0cc7bf63f6e1da"
+	  "274edebfe76f65fbd51ad2f14898b95b" },
+	{ "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+	  "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", 1U,
+	  "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018"
+	  "501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909",
+	  "09330c33f71147e83d192fc782cd1b4753111b173b3b05d22fa08086e3b0f712"
+	  "fcc7c71a557e2db966c3e9fa91746039" },
+	{ "a", 1000000U,
+	  "e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973eb"
+	  "de0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b",
+	  "9d0e1809716474cb086e834e310a4a1ced149e9c00f248527972cec5704c2a5b"
+	  "07b8b3dc38ecc4ebae97ddd87f3d8985" },
+};
+
+static const uint64_t sha512_iv[8] = {
+	0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL,
+	0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+	0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+	0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL,
+};
+
+static const uint64_t sha384_iv[8] = {
+	0xcbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL,
+	0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
+	0x67332667ffc00b31ULL, 0x8eb44a8768581511ULL,
+	0xdb0c2e0d64f98fa7ULL, 0x47b5481dbefa4fa4ULL,
+};
+
+/* Round constants of the reference, kept apart from the ones of the .S */
+static const uint64_t sha512_k_ref[80] = {
+	0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL,
+	0xe9b5dba58189dbbcULL, 0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
+	0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL, 0xd807aa98a3030242ULL,
+	0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+	0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL,
+	0xc19bf174cf692694ULL, 0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
+	0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL, 0x2de92c6f592b0275ULL,
+	0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+	0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL,
+	0xbf597fc7beef0ee4ULL, 0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+	0x06ca6351e003826fULL, 0x142929670a0e6e70ULL, 0x27b70a8546d22ffcULL,
+	0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+	0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL,
+	0x92722c851482353bULL, 0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
+	0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL, 0xd192e819d6ef5218ULL,
+	0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+	0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL,
+	0x34b0bcb5e19b48a8ULL, 0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
+	0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL, 0x748f82ee5defb2fcULL,
+	0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+	0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL,
+	0xc67178f2e372532bULL, 0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
+	0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL, 0x06f067aa72176fbaULL,
+	0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+	0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL,
+	0x431d67c49c100d4cULL, 0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
+	0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+static unsigned int failures;
+
+static void check(int ok, const char *what, size_t off, size_t len)
+{
+	if (!ok) {
+		fprintf(stderr, "FAIL: %s, offset %zu, length %zu\n",
+			what, off, len);
+		failures++;
+	}
+}
+
+static uint64_t rotr64(uint64_t x, unsigned int n)
+{
+	return (x >> n) | (x << (64U - n));
+}
+
+static void sha512_block_ref(uint64_t state[8], const uint8_t *data)
+{
+	uint64_t w[80];
+	uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+	uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+	unsigned int i;
+	unsigned int j;
+
+	for (i = 0U; i < 16U; i++) {
+		w[i] = 0U;
+		for (j = 0U; j < 8U; j++) {
+			w[i] = (w[i] << 8) | data[(i * 8U) + j];
+		}
+	}
+
+	for (i = 16U; i < 80U; i++) {
+		uint64_t s0 = rotr64(w[i - 15U], 1U) ^ rotr64(w[i - 15U], 8U) ^
+			      (w[i - 15U] >> 7);
+		uint64_t s1 = rotr64(w[i - 2U], 19U) ^ rotr64(w[i - 2U], 61U) ^
+			      (w[i - 2U] >> 6);
+
+		w[i] = w[i - 16U] + s0 + w[i - 7U] + s1;
+	}
+
+	for (i = 0U; i < 80U; i++) {
+		uint64_t t1 = h + (rotr64(e, 14U) ^ rotr64(e, 18U) ^
+				   rotr64(e, 41U)) +
+			      ((e & f) ^ (~e & g)) + sha512_k_ref[i] + w[i];
+		uint64_t t2 = (rotr64(a, 28U) ^ rotr64(a, 34U) ^
+			       rotr64(a, 39U)) +
+			      ((a & b) ^ (a & c) ^ (b & c));
+
+		h = g;
+		g = f;
+		f = e;
+		e = d + t1;
+		d = c;
+		c = b;
+		b = a;
+		a = t1 + t2;
+	}
+
+	state[0] += a;
+	state[1] += b;
+	state[2] += c;
+	state[3] += d;
+	state[4] += e;
+	state[5] += f;
+	state[6] += g;
+	state[7] += h;
+}
+
+/* Full SHA-512 or SHA-384 of a message, padded as FIPS 180-4 section 5.1.2 */
+static void sha_hash(block_fn_t block, const uint64_t iv[8],
+		     const uint8_t *msg, size_t len, uint8_t *digest,
+		     size_t digest_len)
+{
+	uint8_t tail[2U * SHA512_BLOCK_SIZE];
+	uint64_t state[8];
+	uint64_t bits = (uint64_t)len * 8U;
+	size_t rest = len % SHA512_BLOCK_SIZE;
+	size_t tail_len;
+	size_t i;
+
+	memcpy(state, iv, sizeof(state));
+
+	for (i = 0U; (i + SHA512_BLOCK_SIZE) <= len; i += SHA512_BLOCK_SIZE) {
+		block(state, msg + i);
+	}
+
+	memset(tail, 0, sizeof(tail));
+	memcpy(tail, msg + i, rest);
+	tail[rest] = 0x80U;
+	tail_len = ((rest + 1U + 16U) <= SHA512_BLOCK_SIZE) ?
+		   SHA512_BLOCK_SIZE : (2U * SHA512_BLOCK_SIZE);
+	for (i = 0U; i < 8U; i++) {
+		tail[tail_len - 1U - i] = (uint8_t)(bits >> (8U * i));
+	}
+
+	for (i = 0U; i < tail_len; i += SHA512_BLOCK_SIZE) {
+		block(state, tail + i);
+	}
+
+	for (i = 0U; i < digest_len; i++) {
+		digest[i] = (uint8_t)(state[i / 8U] >> (56U - (8U * (i % 8U))));
+	}
+}
+
+static int digest_is(const uint8_t *digest, size_t len, const char *hex)
+{
+	char buf[129];
+	size_t i;
+
+	for (i = 0U; i < len; i++) {
+		snprintf(&buf[i * 2U], 3U, "%02x", digest[i]);
+	}
+
+	return strcmp(buf, hex) == 0;
+}
+
+static void test_known_answers(void)
+{
+	uint8_t digest[64];
+	unsigned int i;
+
+	for (i = 0U; i < sizeof(known_answers) / sizeof(known_answers[0]);
+	     i++) {
+		const struct known_answer *ka = &known_answers[i];
+		size_t unit = strlen(ka->data);
+		size_t len = unit * ka->repeat;
+		uint8_t *msg = malloc(len + 1U);
+		size_t n;
+
+		if (msg == NULL) {
+			check(0, "allocation", 0U, len);
+			continue;
+		}
+
+		for (n = 0U; n < ka->repeat; n++) {
+			memcpy(msg + (n * unit), ka->data, unit);
+		}
+
+		sha_hash(sha512_block_ref, sha512_iv, msg, len, digest, 64U);
+		check(digest_is(digest, 64U, ka->sha512),
+		      "SHA-512 reference known answer", 0U, len);
+		sha_hash(sha512_block_neon, sha512_iv, msg, len, digest,
+			 64U);
+		check(digest_is(digest, 64U, ka->sha512),
+		      "SHA-512 NEON known answer", 0U, len);
+		sha_hash(sha512_block_ref, sha384_iv, msg, len, digest, 48U);
+		check(digest_is(digest, 48U, ka->sha384),
+		      "SHA-384 reference known answer", 0U, len);
+		sha_hash(sha512_block_neon, sha384_iv, msg, len, digest,
+			 48U);
+		check(digest_is(digest, 48U, ka->sha384),
+		      "SHA-384 NEON known answer", 0U, len);
+
+		free(msg);
+	}
+}
+
+/* Random states and blocks, then random messages, at every alignment */
+static void test_random(void)
+{
+	static uint8_t buf[RANDOM_BUF_SIZE + 8U];
+	unsigned int run;
+	size_t i;
+
+	srand(0x5EED);
+
+	for (i = 0U; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)rand();
+	}
+
+	for (run = 0U; run < RANDOM_RUNS; run++) {
+		size_t off = run & 7U;
+		size_t len = (size_t)rand() % (RANDOM_BUF_SIZE + 1U);
+		size_t blk = (size_t)rand() %
+			     (RANDOM_BUF_SIZE - SHA512_BLOCK_SIZE + 1U);
+		uint64_t state_ref[8];
+		uint64_t state_neon[8];
+		uint8_t digest_ref[64];
+		uint8_t digest_neon[64];
+
+		for (i = 0U; i < 8U; i++) {
+			state_ref[i] = ((uint64_t)rand() << 42) ^
+				       ((uint64_t)rand() << 21) ^
+				       (uint64_t)rand();
+		}
+		memcpy(state_neon, state_ref, sizeof(state_neon));
+
+		sha512_block_ref(state_ref, buf + off + blk);
+		sha512_block_neon(state_neon, buf + off + blk);
+		check(memcmp(state_ref, state_neon, sizeof(state_ref)) == 0,
+		      "SHA-512 block", off + blk, SHA512_BLOCK_SIZE);
+
+		sha_hash(sha512_block_ref, sha512_iv, buf + off, len,
+			 digest_ref, 64U);
+		sha_hash(sha512_block_neon, sha512_iv, buf + off, len,
+			 digest_neon, 64U);
+		check(memcmp(digest_ref, digest_neon, 64U) == 0, "SHA-512",
+		      off, len);
+	}
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+static volatile uint64_t bench_sink;
+
+static void bench(const char *name, block_fn_t block, const uint8_t *buf)
+{
+	uint64_t state[8];
+	double start = now();
+	double elapsed;
+	unsigned int loops = 0U;
+	size_t i;
+
+	memcpy(state, sha512_iv, sizeof(state));
+
+	do {
+		for (i = 0U; i < BENCH_BUF_SIZE; i += SHA512_BLOCK_SIZE) {
+			block(state, buf + i);
+		}
+		loops++;
+		elapsed = now() - start;
+	} while (elapsed < BENCH_MIN_SECONDS);
+
+	bench_sink = state[0];
+
+	printf("  %-8s %8.1f MiB/s\n", name,
+	       ((double)loops * BENCH_BUF_SIZE) / (elapsed * 1024.0 * 1024.0));
+}
+
+int main(void)
+{
+	uint8_t *buf;
+
+	test_known_answers();
+	test_random();
+
+	if (failures != 0U) {
+		fprintf(stderr, "%u checks failed\n", failures);
+		return EXIT_FAILURE;
+	}
+
+	printf("All checks passed\n");
+
+	buf = malloc(BENCH_BUF_SIZE);
+	if (buf == NULL) {
+		return EXIT_FAILURE;
+	}
+	memset(buf, 0xA5, BENCH_BUF_SIZE);
+
+	printf("SHA-512 block throughput:\n");
+	bench("neon", sha512_block_neon, buf);
+	bench("c", sha512_block_ref, buf);
+
+	free(buf);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,495 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "fmc2_ecc.h"
+
+#define SECTOR_BITS		(FMC2_ECC_SECTOR_SIZE * 8)
+
+/* BCH codes over GF(2^13), primitive polynomial x^13 + x^4 + x^3 + x + 1 */
+#define GF_M			13
+#define GF_N			((1 << GF_M) - 1)
+#define GF_POLY			0x201B
+#define BCH_MAX_T		8
+#define BCH_MAX_PARITY		(GF_M * BCH_MAX_T)
+
+struct bch_code {
+	unsigned int t;
+	unsigned int parity_bits;
+	/* Generator polynomial without its x^parity_bits term */
+	uint64_t gen[2];
+	bool ready;
+};
+
+static uint16_t gf_exp[2 * GF_N];
+static uint16_t gf_log[GF_N + 1];
+static bool gf_ready;
+
+static struct bch_code bch4 = { .t = 4, .parity_bits = GF_M * 4 };
+static struct bch_code bch8 = { .t = 8, .parity_bits = GF_M * 8 };
+
+static void gf_init(void)
+{
+	unsigned int i;
+	unsigned int x = 1;
+
+	if (gf_ready) {
+		return;
+	}
+
+	for (i = 0; i < GF_N; i++) {
+		gf_exp[i] = x;
+		gf_exp[i + GF_N] = x;
+		gf_log[x] = i;
+		x <<= 1;
+		if ((x & (1 << GF_M)) != 0) {
+			x ^= GF_POLY;
+		}
+	}
+
+	gf_ready = true;
+}
+
+static uint16_t gf_mul(uint16_t a, uint16_t b)
+{
+	if ((a == 0) || (b == 0)) {
+		return 0;
+	}
+
+	return gf_exp[gf_log[a] + gf_log[b]];
+}
+
+static uint16_t gf_div(uint16_t a, uint16_t b)
+{
+	if (a == 0) {
+		return 0;
+	}
+
+	return gf_exp[gf_log[a] + GF_N - gf_log[b]];
+}
+
+/*
+ * The generator polynomial is the product of the minimal polynomials of
+ * alpha^1 to alpha^2t, each counted once.
+ */
+static void bch_init(struct bch_code *code)
+{
+	uint8_t gen[BCH_MAX_PARITY + 1];
+	bool done[2 * BCH_MAX_T + 1];
+	unsigned int deg = 0;
+	unsigned int i, j, k;
+
+	if (code->ready) {
+		return;
+	}
+
+	gf_init();
+
+	memset(gen, 0, sizeof(gen));
+	memset(done, 0, sizeof(done));
+	gen[0] = 1;
+
+	for (i = 1; i <= 2 * code->t; i++) {
+		uint16_t min[GF_M + 1];
+		unsigned int min_deg = 0;
+		unsigned int c = i;
+		uint8_t prod[BCH_MAX_PARITY + 1];
+
+		if (done[i]) {
+			continue;
+		}
+
+		/* Product of (x - alpha^c) over the conjugates c of i */
+		memset(min, 0, sizeof(min));
+		min[0] = 1;
+		do {
+			if (c <= 2 * code->t) {
+				done[c] = true;
+			}
+
+			for (j = min_deg + 1; j > 0; j--) {
+				min[j] = min[j - 1] ^ gf_mul(min[j], gf_exp[c]);
+			}
+			min[0] = gf_mul(min[0], gf_exp[c]);
+			min_deg++;
+
+			c = (c * 2) % GF_N;
+		} while (c != i);
+
+		/* The minimal polynomial has binary coefficients */
+		memset(prod, 0, sizeof(prod));
+		for (j = 0; j <= deg; j++) {
+			if (gen[j] == 0) {
+				continue;
+			}
+
+			for (k = 0; k <= min_deg; k++) {
+				prod[j + k] ^= (uint8_t)min[k];
+			}
+		}
+		memcpy(gen, prod, sizeof(gen));
+		deg += min_deg;
+	}
+
+	code->gen[0] = 0;
+	code->gen[1] = 0;
+	for (j = 0; j < code->parity_bits; j++) {
+		if (gen[j] != 0) {
+			code->gen[j / 64] |= (uint64_t)1 << (j % 64);
+		}
+	}
+
+	code->ready = true;
+}
+
+static struct bch_code *bch_get(unsigned int strength)
+{
+	struct bch_code *code;
+
+	switch (strength) {
+	case FMC2_ECC_BCH4:
+		code = &bch4;
+		break;
+	case FMC2_ECC_BCH8:
+		code = &bch8;
+		break;
+	default:
+		return NULL;
+	}
+
+	bch_init(code);
+
+	return code;
+}
+
+static unsigned int get_bit(const uint8_t *buf, unsigned int pos)
+{
+	return (buf[pos / 8] >> (pos % 8)) & 1;
+}
+
+/*
+ * Data bits enter the encoder in the order the FMC2 reports error positions:
+ * bit (pos % 8) of byte (pos / 8), the first one as the highest degree term.
+ * Parity bits are stored the same way, from the highest degree term down.
+ * This order is not checked against the BCHPBR registers of an FMC2.
+ */
+static void bch_calculate(const struct bch_code *code, const uint8_t *data,
+			  uint8_t *ecc)
+{
+	unsigned int top = code->parity_bits - 1;
+	uint64_t mask_hi = (code->parity_bits > 64) ?
+			   (((uint64_t)1 << (code->parity_bits - 64)) - 1) : 0;
+	uint64_t mask_lo = (code->parity_bits >= 64) ?
+			   ~(uint64_t)0 :
+			   (((uint64_t)1 << code->parity_bits) - 1);
+	uint64_t reg[2] = { 0, 0 };
+	unsigned int i;
+
+	for (i = 0; i < SECTOR_BITS; i++) {
+		unsigned int fb = get_bit(data, i) ^
+				  ((reg[top / 64] >> (top % 64)) & 1);
+
+		reg[1] = ((reg[1] << 1) | (reg[0] >> 63)) & mask_hi;
+		reg[0] = (reg[0] << 1) & mask_lo;
+
+		if (fb != 0) {
+			reg[0] ^= code->gen[0];
+			reg[1] ^= code->gen[1];
+		}
+	}
+
+	memset(ecc, 0, (code->parity_bits + 7) / 8);
+	for (i = 0; i < code->parity_bits; i++) {
+		unsigned int deg = top - i;
+
+		if (((reg[deg / 64] >> (deg % 64)) & 1) != 0) {
+			ecc[i / 8] |= 1 << (i % 8);
+		}
+	}
+}
+
+/*
+ * Software replacement for the FMC2 BCH decoder: error positions are
+ * returned in the FMC2_BCHDSRx numbering, parity bits after the data bits.
+ * Returns the number of errors, or -1 when they cannot be located.
+ */
+static int bch_decode(const struct bch_code *code, const uint8_t *data,
+		      const uint8_t *ecc, uint16_t *pos)
+{
+	unsigned int n = SECTOR_BITS + code->parity_bits;
+	uint16_t syn[2 * BCH_MAX_T + 1];
+	uint16_t lambda[BCH_MAX_T + 2];
+	uint16_t prev[BCH_MAX_T + 2];
+	uint16_t tmp[BCH_MAX_T + 2];
+	uint16_t b = 1;
+	unsigned int l = 0, shift = 1;
+	unsigned int i, j, e;
+	int count = 0;
+	bool errors = false;
+
+	/* Syndromes S_j = r(alpha^j) */
+	memset(syn, 0, sizeof(syn));
+	for (e = 0; e < n; e++) {
+		unsigned int bit;
+
+		if (e >= code->parity_bits) {
+			bit = get_bit(data, n - 1 - e);
+		} else {
+			bit = get_bit(ecc, code->parity_bits - 1 - e);
+		}
+
+		if (bit == 0) {
+			continue;
+		}
+
+		for (j = 1; j <= 2 * code->t; j++) {
+			syn[j] ^= gf_exp[(j * e) % GF_N];
+		}
+	}
+
+	for (j = 1; j <= 2 * code->t; j++) {
+		if (syn[j] != 0) {
+			errors = true;
+		}
+	}
+
+	if (!errors) {
+		return 0;
+	}
+
+	/* Berlekamp-Massey: error locator polynomial */
+	memset(lambda, 0, sizeof(lambda));
+	memset(prev, 0, sizeof(prev));
+	lambda[0] = 1;
+	prev[0] = 1;
+
+	for (i = 0; i < 2 * code->t; i++) {
+		uint16_t d = syn[i + 1];
+		uint16_t coef;
+
+		for (j = 1; j <= l; j++) {
+			d ^= gf_mul(lambda[j], syn[i + 1 - j]);
+		}
+
+		if (d == 0) {
+			shift++;
+			continue;
+		}
+
+		coef = gf_div(d, b);
+		memcpy(tmp, lambda, sizeof(tmp));
+		for (j = 0; (j + shift) <= (code->t + 1); j++) {
+			lambda[j + shift] ^= gf_mul(coef, prev[j]);
+		}
+
+		if ((2 * l) <= i) {
+			l = i + 1 - l;
+			memcpy(prev, tmp, sizeof(prev));
+			b = d;
+			shift = 1;
+		} else {
+			shift++;
+		}
+	}
+
+	if (l > code->t) {
+		return -1;
+	}
+
+	/* Chien search over the shortened code positions */
+	for (e = 0; e < n; e++) {
+		uint16_t sum = 0;
+		unsigned int inv = (GF_N - (e % GF_N)) % GF_N;
+
+		for (j = 0; j <= l; j++) {
+			sum ^= gf_mul(lambda[j], gf_exp[(j * inv) % GF_N]);
+		}
+
+		if (sum != 0) {
+			continue;
+		}
+
+		if (e >= code->parity_bits) {
+			pos[count] = n - 1 - e;
+		} else {
+			pos[count] = SECTOR_BITS + code->parity_bits - 1 - e;
+		}
+		count++;
+	}
+
+	if (count != (int)l) {
+		return -1;
+	}
+
+	return count;
+}
+
+/*
+ * FMC2 Hamming code on a 512-byte sector, 24 bits stored little endian.
+ * Parity bit pairs follow the address of a bit in the sector: (2k, 2k + 1)
+ * cover the bits whose address bit k is 0 and 1 respectively, with bit
+ * position in a byte for k = 0 to 2 and byte offset for k = 3 to 11. This
+ * is the layout stm32_fmc2_ham_correct() decodes, not checked against the
+ * HECCR register of an FMC2.
+ */
+static void ham_calculate(const uint8_t *data, uint8_t *ecc)
+{
+	/* Bits of a byte whose position has bit k set */
+	static const uint8_t odd[3] = { 0xAA, 0xCC, 0xF0 };
+	unsigned int col = 0, row = 0, total = 0;
+	uint32_t code = 0;
+	unsigned int k;
+	unsigned int i;
+
+	for (i = 0; i < FMC2_ECC_SECTOR_SIZE; i++) {
+		col ^= data[i];
+		if ((__builtin_popcount(data[i]) & 1) != 0) {
+			row ^= i;
+			total ^= 1;
+		}
+	}
+
+	for (k = 0; k < 3; k++) {
+		unsigned int p = __builtin_popcount(col & odd[k]) & 1;
+		unsigned int q = __builtin_popcount(col & ~odd[k] & 0xFF) & 1;
+
+		code |= (uint32_t)q << (2 * k);
+		code |= (uint32_t)p << (2 * k + 1);
+	}
+
+	for (k = 3; k < 12; k++) {
+		unsigned int p = (row >> (k - 3)) & 1;
+
+		code |= (uint32_t)(total ^ p) << (2 * k);
+		code |= (uint32_t)p << (2 * k + 1);
+	}
+
+	ecc[0] = code;
+	ecc[1] = code >> 8;
+	ecc[2] = code >> 16;
+}
+
+/* Port of stm32_fmc2_ham_correct() */
+static int ham_correct(uint8_t *buffer, const uint8_t *eccbuffer,
+		       const uint8_t *ecc)
+{
+	uint8_t xor_ecc_ones;
+	uint16_t xor_ecc_1b, xor_ecc_2b, xor_ecc_3b;
+	uint32_t xor_ecc;
+
+	xor_ecc_1b = ecc[0] ^ eccbuffer[0];
+	xor_ecc_2b = ecc[1] ^ eccbuffer[1];
+	xor_ecc_3b = ecc[2] ^ eccbuffer[2];
+
+	xor_ecc = xor_ecc_1b | (xor_ecc_2b << 8) | ((uint32_t)xor_ecc_3b << 16);
+	if (xor_ecc == 0) {
+		return 0;
+	}
+
+	xor_ecc_ones = __builtin_popcount(xor_ecc);
+	if (xor_ecc_ones == 12) {
+		uint16_t bit_address, byte_address;
+
+		bit_address = ((xor_ecc_1b >> 1) & 0x1) |
+			      ((xor_ecc_1b >> 2) & 0x2) |
+			      ((xor_ecc_1b >> 3) & 0x4);
+
+		byte_address = ((xor_ecc_1b >> 7) & 0x1) |
+			       ((xor_ecc_2b) & 0x2) |
+			       ((xor_ecc_2b >> 1) & 0x4) |
+			       ((xor_ecc_2b >> 2) & 0x8) |
+			       ((xor_ecc_2b >> 3) & 0x10) |
+			       ((xor_ecc_3b << 4) & 0x20) |
+			       ((xor_ecc_3b << 3) & 0x40) |
+			       ((xor_ecc_3b << 2) & 0x80) |
+			       ((xor_ecc_3b << 1) & 0x100);
+
+		buffer[byte_address] ^= 1 << bit_address;
+
+		return 1;
+	}
+
+	return -1;
+}
+
+/* Port of the error position handling of stm32_fmc2_bch_correct() */
+static int bch_correct(const struct bch_code *code, uint8_t *buffer,
+		       const uint8_t *ecc)
+{
+	uint16_t pos[BCH_MAX_T];
+	int i, den;
+
+	den = bch_decode(code, buffer, ecc, pos);
+	if (den < 0) {
+		return -1;
+	}
+
+	for (i = 0; i < den; i++) {
+		if (pos[i] < SECTOR_BITS) {
+			buffer[pos[i] / 8] ^= 1 << (pos[i] % 8);
+		}
+	}
+
+	return den;
+}
+
+unsigned int fmc2_ecc_bytes(unsigned int strength)
+{
+	switch (strength) {
+	case FMC2_ECC_HAM:
+		return 3;
+	case FMC2_ECC_BCH4:
+		return 7;
+	case FMC2_ECC_BCH8:
+		return 13;
+	default:
+		return 0;
+	}
+}
+
+int fmc2_ecc_calculate(unsigned int strength, const uint8_t *data,
+		       uint8_t *ecc)
+{
+	struct bch_code *code;
+
+	if (strength == FMC2_ECC_HAM) {
+		ham_calculate(data, ecc);
+		return 0;
+	}
+
+	code = bch_get(strength);
+	if (code == NULL) {
+		return -1;
+	}
+
+	bch_calculate(code, data, ecc);
+
+	return 0;
+}
+
+int fmc2_ecc_correct(unsigned int strength, uint8_t *data,
+		     const uint8_t *ecc)
+{
+	struct bch_code *code;
+
+	if (strength == FMC2_ECC_HAM) {
+		uint8_t ecc_cal[3];
+
+		ham_calculate(data, ecc_cal);
+
+		return ham_correct(data, ecc, ecc_cal);
+	}
+
+	code = bch_get(strength);
+	if (code == NULL) {
+		return -1;
+	}
+
+	return bch_correct(code, data, ecc);
+}
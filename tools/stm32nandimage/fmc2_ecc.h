@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef FMC2_ECC_H
+#define FMC2_ECC_H
+
+#include <stdint.h>
+
+/* ECC sector size, as programmed in FMC2_PCR.ECCSS by the driver */
+#define FMC2_ECC_SECTOR_SIZE	512
+/* Bad block marker bytes at the start of the OOB area */
+#define FMC2_BBM_LEN		2
+#define FMC2_MAX_ECC_BYTES	14
+
+/* Same values as the nand->ecc.max_bit_corr handled by the FMC2 driver */
+enum stm32_fmc2_ecc {
+	FMC2_ECC_HAM = 1,
+	FMC2_ECC_BCH4 = 4,
+	FMC2_ECC_BCH8 = 8
+};
+
+/* ECC bytes per sector on an 8-bit bus, 0 for an unsupported strength */
+unsigned int fmc2_ecc_bytes(unsigned int strength);
+
+/*
+ * Compute the ECC bytes of a 512-byte sector, as stored in the OOB area.
+ * Returns 0, or -1 for an unsupported strength.
+ */
+int fmc2_ecc_calculate(unsigned int strength, const uint8_t *data,
+		       uint8_t *ecc);
+
+/*
+ * Check a sector read back with its stored ECC bytes and fix the data in
+ * place the way the FMC2 driver does. Returns the number of bits corrected,
+ * or -1 when the sector is uncorrectable.
+ */
+int fmc2_ecc_correct(unsigned int strength, uint8_t *data,
+		     const uint8_t *ecc);
+
+#endif /* FMC2_ECC_H */
@@ -0,0 +1,620 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "fmc2_ecc.h"
+
+#define DEFAULT_PAGE_SIZE	4096
+#define DEFAULT_OOB_SIZE	224
+#define DEFAULT_PAGES_PER_BLOCK	64
+#define DEFAULT_BLOCKS		2048
+#define DEFAULT_FSBL_COPIES	2
+/* Default STM32MP_NAND_FIP_OFFSET */
+#define DEFAULT_FIP_OFFSET	0x200000
+#define MAX_PARTS		8
+#define SELFTEST_SECTORS	200
+
+struct part {
+	char name[16];
+	const char *file;
+	size_t size;
+	unsigned int *blocks;
+	unsigned int nb_blocks;
+};
+
+struct nand_image {
+	unsigned int page_size;
+	unsigned int oob_size;
+	unsigned int pages_per_block;
+	unsigned int blocks;
+	unsigned int ecc;
+	bool *bad;
+	/* Raw content of the blocks covered by the output image */
+	uint8_t *buf;
+	unsigned int used_blocks;
+	struct part parts[MAX_PARTS];
+	unsigned int nb_parts;
+};
+
+static const char *ecc_name(unsigned int ecc)
+{
+	switch (ecc) {
+	case FMC2_ECC_HAM:
+		return "ham";
+	case FMC2_ECC_BCH4:
+		return "bch4";
+	default:
+		return "bch8";
+	}
+}
+
+static size_t raw_page_size(const struct nand_image *img)
+{
+	return img->page_size + img->oob_size;
+}
+
+static size_t raw_block_size(const struct nand_image *img)
+{
+	return raw_page_size(img) * img->pages_per_block;
+}
+
+static size_t block_size(const struct nand_image *img)
+{
+	return (size_t)img->page_size * img->pages_per_block;
+}
+
+static int parse_bad_blocks(struct nand_image *img, char *list)
+{
+	char *tok;
+
+	for (tok = strtok(list, ","); tok != NULL; tok = strtok(NULL, ",")) {
+		unsigned long block = strtoul(tok, NULL, 0);
+
+		if (block >= img->blocks) {
+			fprintf(stderr, "Bad block %lu out of device\n", block);
+			return -1;
+		}
+
+		img->bad[block] = true;
+	}
+
+	return 0;
+}
+
+static uint8_t *read_file(const char *name, size_t *size)
+{
+	FILE *f;
+	long len;
+	uint8_t *buf;
+
+	f = fopen(name, "rb");
+	if (f == NULL) {
+		fprintf(stderr, "Can't open %s: %s\n", name, strerror(errno));
+		return NULL;
+	}
+
+	if ((fseek(f, 0, SEEK_END) != 0) || ((len = ftell(f)) < 0) ||
+	    (fseek(f, 0, SEEK_SET) != 0)) {
+		fprintf(stderr, "Can't read %s\n", name);
+		fclose(f);
+		return NULL;
+	}
+
+	buf = malloc(len + 1);
+	if (buf == NULL) {
+		fclose(f);
+		return NULL;
+	}
+
+	if (fread(buf, 1, len, f) != (size_t)len) {
+		fprintf(stderr, "Can't read %s\n", name);
+		free(buf);
+		fclose(f);
+		return NULL;
+	}
+
+	fclose(f);
+	*size = len;
+
+	return buf;
+}
+
+/* Extend the image up to a block, the new blocks erased */
+static int grow(struct nand_image *img, unsigned int nb_blocks)
+{
+	uint8_t *buf;
+
+	if (nb_blocks <= img->used_blocks) {
+		return 0;
+	}
+
+	buf = realloc(img->buf, nb_blocks * raw_block_size(img));
+	if (buf == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		return -1;
+	}
+
+	memset(buf + (img->used_blocks * raw_block_size(img)), 0xFF,
+	       (nb_blocks - img->used_blocks) * raw_block_size(img));
+	img->buf = buf;
+	img->used_blocks = nb_blocks;
+
+	return 0;
+}
+
+/*
+ * Program one page of the image: data padded with 0xFF, bad block marker
+ * bytes left erased, ECC of each sector following in the OOB area.
+ */
+static void write_page(struct nand_image *img, unsigned int block,
+		       unsigned int page, const uint8_t *data, size_t len)
+{
+	uint8_t *p = img->buf + (block * raw_block_size(img)) +
+		     (page * raw_page_size(img));
+	uint8_t *oob = p + img->page_size + FMC2_BBM_LEN;
+	unsigned int eccbytes = fmc2_ecc_bytes(img->ecc);
+	unsigned int s;
+
+	memcpy(p, data, len);
+
+	for (s = 0; s < (img->page_size / FMC2_ECC_SECTOR_SIZE); s++) {
+		fmc2_ecc_calculate(img->ecc, p + (s * FMC2_ECC_SECTOR_SIZE),
+				   oob + (s * eccbytes));
+	}
+}
+
+/*
+ * Place a file from the start of a block, skipping bad blocks the way
+ * nand_read() does. Returns the block following the last one used, or -1.
+ */
+static int place(struct nand_image *img, const char *name, const char *file,
+		 const uint8_t *data, size_t size, unsigned int block)
+{
+	struct part *part = &img->parts[img->nb_parts];
+	unsigned int needed = (size + block_size(img) - 1) / block_size(img);
+	size_t off = 0;
+
+	if (img->nb_parts == MAX_PARTS) {
+		return -1;
+	}
+
+	part->blocks = calloc(needed, sizeof(unsigned int));
+	if (part->blocks == NULL) {
+		return -1;
+	}
+
+	snprintf(part->name, sizeof(part->name), "%s", name);
+	part->file = file;
+	part->size = size;
+	part->nb_blocks = 0;
+
+	while (part->nb_blocks < needed) {
+		unsigned int page;
+
+		if (block >= img->blocks) {
+			fprintf(stderr, "No room left for %s\n", name);
+			return -1;
+		}
+
+		if (img->bad[block]) {
+			block++;
+			continue;
+		}
+
+		if (grow(img, block + 1) != 0) {
+			return -1;
+		}
+
+		for (page = 0; (page < img->pages_per_block) && (off < size);
+		     page++) {
+			size_t len = size - off;
+
+			if (len > img->page_size) {
+				len = img->page_size;
+			}
+
+			write_page(img, block, page, data + off, len);
+			off += len;
+		}
+
+		part->blocks[part->nb_blocks++] = block;
+		block++;
+	}
+
+	img->nb_parts++;
+
+	return block;
+}
+
+static int write_image(const struct nand_image *img, const char *name)
+{
+	FILE *f = fopen(name, "wb");
+	size_t len = img->used_blocks * raw_block_size(img);
+
+	if (f == NULL) {
+		fprintf(stderr, "Can't open %s: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	if (fwrite(img->buf, 1, len, f) != len) {
+		fprintf(stderr, "Write error on %s: %s\n", name,
+			strerror(errno));
+		fclose(f);
+		return -1;
+	}
+
+	fclose(f);
+
+	return 0;
+}
+
+/*
+ * Manifest for gang programmers: one "key value" line per setting, then one
+ * line per partition with the physical blocks holding it, in order.
+ */
+static void print_manifest(const struct nand_image *img, FILE *f)
+{
+	unsigned int i, j;
+	bool first = true;
+
+	fprintf(f, "page_size %u\n", img->page_size);
+	fprintf(f, "oob_size %u\n", img->oob_size);
+	fprintf(f, "pages_per_block %u\n", img->pages_per_block);
+	fprintf(f, "blocks %u\n", img->blocks);
+	fprintf(f, "ecc %s\n", ecc_name(img->ecc));
+	fprintf(f, "ecc_sector_size %u\n", FMC2_ECC_SECTOR_SIZE);
+	fprintf(f, "ecc_bytes %u\n", fmc2_ecc_bytes(img->ecc));
+	fprintf(f, "ecc_oob_offset %u\n", FMC2_BBM_LEN);
+	/* ECC bytes not compared with the ones of an FMC2 yet */
+	fprintf(f, "ecc_hw_verified no\n");
+	fprintf(f, "image_blocks %u\n", img->used_blocks);
+
+	fprintf(f, "bad_blocks");
+	for (i = 0; i < img->blocks; i++) {
+		if (img->bad[i]) {
+			fprintf(f, "%s%u", first ? " " : ",", i);
+			first = false;
+		}
+	}
+	fprintf(f, "\n");
+
+	for (i = 0; i < img->nb_parts; i++) {
+		const struct part *part = &img->parts[i];
+
+		fprintf(f, "part %s %s size %zu blocks", part->name,
+			part->file, part->size);
+		for (j = 0; j < part->nb_blocks; j++) {
+			fprintf(f, "%s%u", (j == 0) ? " " : ",",
+				part->blocks[j]);
+		}
+		fprintf(f, "\n");
+	}
+}
+
+static int write_manifest(const struct nand_image *img, const char *name)
+{
+	FILE *f = fopen(name, "w");
+
+	if (f == NULL) {
+		fprintf(stderr, "Can't open %s: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	print_manifest(img, f);
+	fclose(f);
+
+	return 0;
+}
+
+/*
+ * Check the ECC of random sectors against the port of the FMC2 correction
+ * code: up to the code strength, injected bit flips must be corrected.
+ */
+static int selftest_ecc(unsigned int ecc)
+{
+	unsigned int eccbytes = fmc2_ecc_bytes(ecc);
+	uint8_t data[FMC2_ECC_SECTOR_SIZE];
+	uint8_t ref[FMC2_ECC_SECTOR_SIZE];
+	uint8_t code[FMC2_MAX_ECC_BYTES];
+	unsigned int n, i;
+
+	for (n = 0; n < SELFTEST_SECTORS; n++) {
+		unsigned int flips = (n % ecc) + 1;
+		int ret;
+
+		for (i = 0; i < FMC2_ECC_SECTOR_SIZE; i++) {
+			ref[i] = rand();
+		}
+
+		fmc2_ecc_calculate(ecc, ref, code);
+		memcpy(data, ref, sizeof(data));
+
+		if (fmc2_ecc_correct(ecc, data, code) != 0) {
+			fprintf(stderr, "%s: error on a clean sector\n",
+				ecc_name(ecc));
+			return -1;
+		}
+
+		/* Distinct bit flips, a BCH one in the ECC bytes at times */
+		for (i = 0; i < flips; i++) {
+			unsigned int bit = rand() % (FMC2_ECC_SECTOR_SIZE * 8);
+
+			if ((ecc != FMC2_ECC_HAM) && (i == 1) && ((n & 1) != 0)) {
+				code[rand() % (eccbytes - 1)] ^= 1 << (rand() % 8);
+				continue;
+			}
+
+			if (((data[bit / 8] ^ ref[bit / 8]) & (1 << (bit % 8))) != 0) {
+				i--;
+				continue;
+			}
+
+			data[bit / 8] ^= 1 << (bit % 8);
+		}
+
+		ret = fmc2_ecc_correct(ecc, data, code);
+		if ((ret != (int)flips) || (memcmp(data, ref, sizeof(data)) != 0)) {
+			fprintf(stderr, "%s: %u bit flips not corrected (%d)\n",
+				ecc_name(ecc), flips, ret);
+			return -1;
+		}
+	}
+
+	printf("%-4s : %u sectors corrected\n", ecc_name(ecc), n);
+
+	return 0;
+}
+
+/* Read a programmed page back through the ECC, as the FMC2 driver does */
+static int check_page(const struct nand_image *img, unsigned int block,
+		      unsigned int page)
+{
+	const uint8_t *p = img->buf + (block * raw_block_size(img)) +
+			   (page * raw_page_size(img));
+	const uint8_t *oob = p + img->page_size + FMC2_BBM_LEN;
+	unsigned int eccbytes = fmc2_ecc_bytes(img->ecc);
+	uint8_t sector[FMC2_ECC_SECTOR_SIZE];
+	unsigned int s;
+
+	for (s = 0; s < (img->page_size / FMC2_ECC_SECTOR_SIZE); s++) {
+		memcpy(sector, p + (s * FMC2_ECC_SECTOR_SIZE), sizeof(sector));
+		if (fmc2_ecc_correct(img->ecc, sector,
+				     oob + (s * eccbytes)) != 0) {
+			fprintf(stderr, "ECC check failed: block %u page %u\n",
+				block, page);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static int check_image(const struct nand_image *img)
+{
+	unsigned int i, page;
+
+	for (i = 0; i < img->nb_parts; i++) {
+		const struct part *part = &img->parts[i];
+		unsigned int pages = (part->size + img->page_size - 1) /
+				     img->page_size;
+
+		for (page = 0; page < pages; page++) {
+			if (check_page(img,
+				       part->blocks[page / img->pages_per_block],
+				       page % img->pages_per_block) != 0) {
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static void usage(const char *name)
+{
+	fprintf(stderr,
+		"Usage : %s [-p page_size] [-o oob_size] [-b pages_per_block] [-n blocks]\n"
+		"        [-e ham|bch4|bch8] [-B bad_block[,bad_block...]]\n"
+		"        [-s fsbl_file] [-c fsbl_copies] [-f fip_file] [-O fip_offset]\n"
+		"        [-d destfile] [-m manifest]\n"
+		"       %s -t\n", name, name);
+}
+
+int main(int argc, char *argv[])
+{
+	struct nand_image img;
+	char *bad_list = NULL;
+	char *fsbl = NULL, *fip = NULL, *dest = NULL, *manifest = NULL;
+	unsigned long fip_offset = DEFAULT_FIP_OFFSET;
+	unsigned int copies = DEFAULT_FSBL_COPIES;
+	bool selftest = false;
+	uint8_t *data;
+	size_t size;
+	int block = 0;
+	unsigned int i;
+	int opt, err = 0;
+
+	memset(&img, 0, sizeof(img));
+	img.page_size = DEFAULT_PAGE_SIZE;
+	img.oob_size = DEFAULT_OOB_SIZE;
+	img.pages_per_block = DEFAULT_PAGES_PER_BLOCK;
+	img.blocks = DEFAULT_BLOCKS;
+	img.ecc = FMC2_ECC_BCH8;
+
+	while ((opt = getopt(argc, argv, ":p:o:b:n:e:B:s:c:f:O:d:m:t")) != -1) {
+		switch (opt) {
+		case 'p':
+			img.page_size = strtoul(optarg, NULL, 0);
+			break;
+		case 'o':
+			img.oob_size = strtoul(optarg, NULL, 0);
+			break;
+		case 'b':
+			img.pages_per_block = strtoul(optarg, NULL, 0);
+			break;
+		case 'n':
+			img.blocks = strtoul(optarg, NULL, 0);
+			break;
+		case 'e':
+			if (strcmp(optarg, "ham") == 0) {
+				img.ecc = FMC2_ECC_HAM;
+			} else if (strcmp(optarg, "bch4") == 0) {
+				img.ecc = FMC2_ECC_BCH4;
+			} else if (strcmp(optarg, "bch8") == 0) {
+				img.ecc = FMC2_ECC_BCH8;
+			} else {
+				fprintf(stderr, "Unknown ECC %s\n", optarg);
+				return -1;
+			}
+			break;
+		case 'B':
+			bad_list = optarg;
+			break;
+		case 's':
+			fsbl = optarg;
+			break;
+		case 'c':
+			copies = strtoul(optarg, NULL, 0);
+			break;
+		case 'f':
+			fip = optarg;
+			break;
+		case 'O':
+			fip_offset = strtoul(optarg, NULL, 0);
+			break;
+		case 'd':
+			dest = optarg;
+			break;
+		case 'm':
+			manifest = optarg;
+			break;
+		case 't':
+			selftest = true;
+			break;
+		default:
+			usage(argv[0]);
+			return -1;
+		}
+	}
+
+	if (selftest) {
+		srand(1);
+		if ((selftest_ecc(FMC2_ECC_HAM) != 0) ||
+		    (selftest_ecc(FMC2_ECC_BCH4) != 0) ||
+		    (selftest_ecc(FMC2_ECC_BCH8) != 0)) {
+			return -1;
+		}
+
+		return 0;
+	}
+
+	if (!dest) {
+		fprintf(stderr, "Missing -d option\n");
+		return -1;
+	}
+
+	if ((fsbl == NULL) && (fip == NULL)) {
+		fprintf(stderr, "Missing -s or -f option\n");
+		return -1;
+	}
+
+	if ((img.page_size == 0) ||
+	    ((img.page_size % FMC2_ECC_SECTOR_SIZE) != 0) ||
+	    (img.pages_per_block == 0) || (img.blocks == 0)) {
+		fprintf(stderr, "Invalid NAND geometry\n");
+		return -1;
+	}
+
+	if ((FMC2_BBM_LEN + (img.page_size / FMC2_ECC_SECTOR_SIZE) *
+	     fmc2_ecc_bytes(img.ecc)) > img.oob_size) {
+		fprintf(stderr, "OOB too small for %s ECC\n",
+			ecc_name(img.ecc));
+		return -1;
+	}
+
+	if ((fip_offset % block_size(&img)) != 0) {
+		fprintf(stderr, "FIP offset not aligned on a block\n");
+		return -1;
+	}
+
+	img.bad = calloc(img.blocks, sizeof(bool));
+	if (img.bad == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		return -1;
+	}
+
+	if ((bad_list != NULL) && (parse_bad_blocks(&img, bad_list) != 0)) {
+		return -1;
+	}
+
+	/* FSBL copies one after the other, from the first good block */
+	if (fsbl != NULL) {
+		data = read_file(fsbl, &size);
+		if (data == NULL) {
+			return -1;
+		}
+
+		for (i = 0; (i < copies) && (block >= 0); i++) {
+			char name[16];
+
+			snprintf(name, sizeof(name), "fsbl%u", i + 1);
+			block = place(&img, name, fsbl, data, size, block);
+		}
+
+		free(data);
+		if (block < 0) {
+			return -1;
+		}
+	}
+
+	if (fip != NULL) {
+		unsigned int fip_block = fip_offset / block_size(&img);
+
+		if (fip_block < (unsigned int)block) {
+			fprintf(stderr, "FIP offset overlaps the FSBL copies\n");
+			return -1;
+		}
+
+		data = read_file(fip, &size);
+		if (data == NULL) {
+			return -1;
+		}
+
+		block = place(&img, "fip", fip, data, size, fip_block);
+		free(data);
+		if (block < 0) {
+			return -1;
+		}
+	}
+
+	err = check_image(&img);
+	if (err == 0) {
+		err = write_image(&img, dest);
+	}
+
+	if ((err == 0) && (manifest != NULL)) {
+		err = write_manifest(&img, manifest);
+	}
+
+	if (err == 0) {
+		print_manifest(&img, stdout);
+	}
+
+	for (i = 0; i < img.nb_parts; i++) {
+		free(img.parts[i].blocks);
+	}
+	free(img.buf);
+	free(img.bad);
+
+	return err;
+}